@@ -0,0 +1,131 @@
+#include "analysis/analysis.h"
+#include "nnue/nnue.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+static std::array<std::string_view, 7> constexpr k_options{
+    "--threads", "--hash",     "--window", "--depth",
+    "--nodes",   "--movetime", "--eval",
+};
+
+template <typename Number>
+static auto parse(std::string_view const text, Number &number) -> bool {
+    auto const [end, error] =
+        std::from_chars(text.data(), text.data() + text.size(), number);
+
+    return error == std::errc{} && end == text.data() + text.size();
+}
+
+static auto usage(std::string_view const error) -> std::int32_t {
+    std::cerr << std::format(
+        "{}\nusage: chess-analyse [--threads n] [--hash mb] [--window n] "
+        "[--depth n] [--nodes n] [--movetime ms] [--eval file] [positions]\n",
+        error
+    );
+
+    return 1;
+}
+
+std::int32_t main(std::int32_t argc, char *argv[]) {
+    std::ios::sync_with_stdio(false);
+
+    AnalysisOptions options;
+    char const *path = nullptr;
+
+    for (std::int32_t i = 1; i < argc; ++i) {
+        std::string_view const argument = argv[i];
+
+        if (!argument.starts_with("--")) {
+            path = argv[i];
+
+            continue;
+        }
+
+        if (std::ranges::find(k_options, argument) == k_options.end())
+            return usage(std::format("unknown option {}", argument));
+
+        if (i + 1 >= argc)
+            return usage(std::format("missing value for {}", argument));
+
+        std::string_view const value = argv[++i];
+        std::int64_t milliseconds = 0;
+        bool parsed = true;
+
+        if (argument == "--threads") {
+            parsed = parse(value, options.threads);
+        } else if (argument == "--hash") {
+            parsed = parse(value, options.hash);
+        } else if (argument == "--window") {
+            parsed = parse(value, options.window);
+        } else if (argument == "--depth") {
+            parsed = parse(value, options.limits.depth);
+            options.limits.depth =
+                std::clamp(options.limits.depth, 1, k_max_ply - 1);
+        } else if (argument == "--nodes") {
+            parsed = parse(value, options.limits.nodes);
+        } else if (argument == "--movetime") {
+            parsed = parse(value, milliseconds) && milliseconds >= 0;
+            options.limits.movetime = std::chrono::milliseconds(milliseconds);
+        } else {
+            k_network = Network::load(argv[i]);
+
+            if (!k_network) {
+                std::cerr << std::format("cannot load network {}\n", value);
+
+                return 1;
+            }
+        }
+
+        if (!parsed)
+            return usage(
+                std::format("invalid value {} for {}", value, argument)
+            );
+    }
+
+    std::ifstream file;
+
+    if (path) {
+        file.open(path);
+
+        if (!file) {
+            std::cerr << std::format("cannot open {}\n", path);
+
+            return 1;
+        }
+    }
+
+    Analyser analyser(options);
+
+    AnalysisSummary const summary =
+        analyser.run(path ? file : std::cin, std::cout);
+
+    double const seconds =
+        std::chrono::duration<double>(summary.elapsed).count();
+
+    std::cerr << std::format(
+        "{} positions in {:.2f} s, {:.1f} positions/s\n", summary.positions,
+        seconds, seconds > 0 ? summary.positions / seconds : 0.0
+    );
+
+    for (std::size_t i = 0; i < summary.workers.size(); ++i) {
+        WorkerStats const &worker = summary.workers[i];
+
+        double const busy =
+            std::chrono::duration<double>(worker.busy).count();
+
+        std::cerr << std::format(
+            "worker {}: {} positions, {:.1f}% busy\n", i, worker.positions,
+            seconds > 0 ? 100 * busy / seconds : 0.0
+        );
+    }
+
+    delete k_network;
+
+    return 0;
+}
@@ -0,0 +1,257 @@
+#include "analysis.h"
+
+#include "../board/board.h"
+#include "../search/table.h"
+
+#include <algorithm>
+#include <format>
+#include <ranges>
+#include <sstream>
+#include <thread>
+
+static auto json_string(std::string_view const text) -> std::string {
+    std::string json = "\"";
+
+    for (char const c : text) {
+        switch (c) {
+        case '"':
+            json += "\\\"";
+            break;
+        case '\\':
+            json += "\\\\";
+            break;
+        case '\t':
+            json += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+                json += std::format("\\u{:04x}", c);
+            else
+                json += c;
+        }
+    }
+
+    return json + '"';
+}
+
+static auto json_score(Score const score) -> std::string {
+    if (std::abs(score) < k_mate - k_max_ply)
+        return std::format("{{\"cp\":{}}}", score);
+
+    std::int32_t const moves = (k_mate - std::abs(score) + 1) / 2;
+
+    return std::format("{{\"mate\":{}}}", score > 0 ? moves : -moves);
+}
+
+static auto split_epd(std::string_view const line)
+    -> std::pair<std::string, std::string_view> {
+    auto const is_digit = [](char const c) -> bool {
+        return c >= '0' && c <= '9';
+    };
+
+    std::vector<std::string_view> fields;
+    std::size_t position = 0;
+
+    while (fields.size() < 6) {
+        position = line.find_first_not_of(' ', position);
+
+        if (position == std::string_view::npos)
+            break;
+
+        std::size_t const end = std::min(line.find(' ', position), line.size());
+
+        std::string_view const field = line.substr(position, end - position);
+
+        if (fields.size() >= 4 && !std::ranges::all_of(field, is_digit))
+            break;
+
+        fields.push_back(field);
+        position = end;
+    }
+
+    if (fields.size() == 5)
+        fields.pop_back();
+
+    std::string fen;
+
+    for (std::string_view const field : fields) {
+        if (!fen.empty())
+            fen += ' ';
+
+        fen += field;
+    }
+
+    std::size_t const operations =
+        fields.empty() ? line.size()
+                       : fields.back().data() + fields.back().size() -
+                             line.data();
+
+    return {fen, line.substr(operations)};
+}
+
+static auto epd_id(std::string_view const operations) -> std::string_view {
+    std::size_t const start = operations.find("id \"");
+
+    if (start == std::string_view::npos)
+        return {};
+
+    std::size_t const end = operations.find('"', start + 4);
+
+    if (end == std::string_view::npos)
+        return {};
+
+    return operations.substr(start + 4, end - start - 4);
+}
+
+static auto analyse(
+    std::uint64_t const index, std::string_view const line,
+    Searcher &searcher, Limits const &limits
+) -> std::string {
+    auto const [fen, operations] = split_epd(line);
+
+    std::string json = std::format("{{\"index\":{}", index);
+
+    if (std::string_view const id = epd_id(operations); !id.empty())
+        json += std::format(",\"id\":{}", json_string(id));
+
+    if (!load_fen(fen))
+        return json + std::format(
+                          ",\"input\":{},\"error\":\"invalid fen\"}}",
+                          json_string(line)
+                      );
+
+    auto const start = std::chrono::steady_clock::now();
+
+    Result const result = searcher.search(limits);
+
+    auto const elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start
+        );
+
+    json += std::format(
+        ",\"fen\":{},\"bestmove\":{},\"score\":{},\"depth\":{},"
+        "\"nodes\":{},\"time_ms\":{},\"pv\":[",
+        json_string(fen),
+        result.pv.empty() ? "null" : json_string(to_uci(result.pv.front())),
+        json_score(result.score), result.depth, result.nodes,
+        elapsed.count()
+    );
+
+    for (std::size_t i = 0; i < result.pv.size(); ++i)
+        json += std::format(
+            "{}{}", i ? "," : "", json_string(to_uci(result.pv[i]))
+        );
+
+    return json + "]}";
+}
+
+Analyser::Analyser(AnalysisOptions const &options) : options(options) {
+    if (this->options.threads < 1)
+        this->options.threads = 1;
+
+    if (this->options.window == 0)
+        this->options.window =
+            4 * static_cast<std::size_t>(this->options.threads);
+}
+
+auto Analyser::run(std::istream &input, std::ostream &output)
+    -> AnalysisSummary {
+    auto const start = std::chrono::steady_clock::now();
+
+    this->output = &output;
+    this->next = 0;
+    this->finished = false;
+
+    AnalysisSummary summary{
+        .workers = std::vector<WorkerStats>(this->options.threads),
+    };
+
+    std::vector<std::thread> workers;
+
+    for (WorkerStats &stats : summary.workers)
+        workers.emplace_back([this, &stats]() -> void { this->work(stats); });
+
+    for (std::string line; std::getline(input, line);) {
+        if (line.empty() || line.front() == '#')
+            continue;
+
+        std::unique_lock lock(this->mutex);
+
+        this->space_ready.wait(lock, [this, &summary]() -> bool {
+            return summary.positions < this->next + this->options.window;
+        });
+
+        this->jobs.push_back({summary.positions++, std::move(line)});
+
+        lock.unlock();
+
+        this->work_ready.notify_one();
+    }
+
+    {
+        std::lock_guard const lock(this->mutex);
+
+        this->finished = true;
+    }
+
+    this->work_ready.notify_all();
+
+    for (std::thread &worker : workers)
+        worker.join();
+
+    output.flush();
+
+    summary.elapsed = std::chrono::steady_clock::now() - start;
+
+    return summary;
+}
+
+void Analyser::work(WorkerStats &stats) {
+    TranspositionTable table(this->options.hash);
+    Signals signals;
+    Searcher searcher(table, signals);
+
+    while (true) {
+        std::unique_lock lock(this->mutex);
+
+        this->work_ready.wait(lock, [this]() -> bool {
+            return this->finished || !this->jobs.empty();
+        });
+
+        if (this->jobs.empty())
+            break;
+
+        Job const job = std::move(this->jobs.front());
+        this->jobs.pop_front();
+
+        lock.unlock();
+
+        auto const start = std::chrono::steady_clock::now();
+
+        std::string result =
+            analyse(job.index, job.line, searcher, this->options.limits);
+
+        stats.busy += std::chrono::steady_clock::now() - start;
+        ++stats.positions;
+
+        this->deliver(job.index, std::move(result));
+    }
+
+    clear_board();
+}
+
+void Analyser::deliver(std::uint64_t const index, std::string result) {
+    {
+        std::lock_guard const lock(this->mutex);
+
+        this->pending.emplace(index, std::move(result));
+
+        for (auto it = this->pending.begin();
+             it != this->pending.end() && it->first == this->next;
+             it = this->pending.erase(it), ++this->next)
+            *this->output << it->second << '\n';
+    }
+
+    this->space_ready.notify_one();
+}
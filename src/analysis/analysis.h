@@ -0,0 +1,67 @@
+#ifndef ANALYSIS_H
+#define ANALYSIS_H
+
+#include "../search/search.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+struct AnalysisOptions final {
+    std::int32_t threads = 1;
+    std::size_t hash = 16;
+    std::size_t window = 0;
+    Limits limits{.depth = 6};
+};
+
+struct WorkerStats final {
+    std::uint64_t positions = 0;
+    std::chrono::nanoseconds busy{};
+};
+
+struct AnalysisSummary final {
+    std::uint64_t positions = 0;
+    std::chrono::nanoseconds elapsed{};
+    std::vector<WorkerStats> workers;
+};
+
+class Analyser final {
+  public:
+    explicit Analyser(AnalysisOptions const &options);
+
+    [[nodiscard]] auto run(std::istream &input, std::ostream &output)
+        -> AnalysisSummary;
+
+  private:
+    struct Job final {
+        std::uint64_t index;
+        std::string line;
+    };
+
+    AnalysisOptions options;
+
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable space_ready;
+
+    std::deque<Job> jobs;
+    std::map<std::uint64_t, std::string> pending;
+    std::uint64_t next = 0;
+    bool finished = false;
+
+    std::ostream *output = nullptr;
+
+    void work(WorkerStats &stats);
+
+    void deliver(std::uint64_t index, std::string result);
+};
+
+#endif // ANALYSIS_H
@@ -0,0 +1,366 @@
+#include "archive.h"
+
+#include "../board/board.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static std::array<char, 4> constexpr k_magic{'C', 'H', 'S', 'A'};
+static std::uint32_t constexpr k_version = 1;
+
+struct Header final {
+    std::array<char, 4> magic = k_magic;
+    std::uint32_t version = k_version;
+    std::uint64_t count = 0;
+    std::uint64_t index = sizeof(Header);
+};
+
+static_assert(sizeof(Header) == 24);
+
+struct Cursor final {
+    std::span<char const> bytes;
+    std::size_t position = 0;
+
+    [[nodiscard]] auto take(std::size_t const size)
+        -> std::optional<std::string_view> {
+        if (this->bytes.size() - this->position < size)
+            return std::nullopt;
+
+        std::string_view const view(this->bytes.data() + this->position, size);
+
+        this->position += size;
+
+        return view;
+    }
+
+    template <typename T> [[nodiscard]] auto read() -> std::optional<T> {
+        std::optional<std::string_view> const view = this->take(sizeof(T));
+
+        if (!view)
+            return std::nullopt;
+
+        T value;
+        std::memcpy(&value, view->data(), sizeof(T));
+
+        return value;
+    }
+};
+
+template <typename T> static void write(std::string &bytes, T const value) {
+    bytes.append(reinterpret_cast<char const *>(&value), sizeof(T));
+}
+
+static auto start_fen(ArchivedGame const &game) -> std::string_view {
+    std::string_view const fen = game.tag("FEN");
+
+    return fen.empty() ? k_start_fen : fen;
+}
+
+static auto valid(Header const &header, std::size_t const length) -> bool {
+    return header.magic == k_magic && header.version == k_version &&
+           header.index % alignof(std::uint64_t) == 0 &&
+           header.index >= sizeof(Header) && header.index <= length &&
+           header.count <= (length - header.index) / sizeof(std::uint64_t);
+}
+
+auto ArchivedGame::tag(std::string_view const key) const -> std::string_view {
+    auto const found = std::ranges::find(
+        this->tags, key,
+        [](std::pair<std::string, std::string> const &tag)
+            -> std::string_view { return tag.first; }
+    );
+
+    return found == this->tags.end() ? "" : std::string_view(found->second);
+}
+
+auto encode_game(ArchivedGame const &game) -> std::optional<std::string> {
+    if (game.tags.size() > std::numeric_limits<std::uint8_t>::max() ||
+        game.moves.size() > std::numeric_limits<std::uint16_t>::max())
+        return std::nullopt;
+
+    std::string bytes;
+
+    write(bytes, static_cast<std::uint8_t>(game.tags.size()));
+
+    for (auto const &[key, value] : game.tags) {
+        if (key.size() > std::numeric_limits<std::uint8_t>::max() ||
+            value.size() > std::numeric_limits<std::uint16_t>::max())
+            return std::nullopt;
+
+        write(bytes, static_cast<std::uint8_t>(key.size()));
+        bytes += key;
+        write(bytes, static_cast<std::uint16_t>(value.size()));
+        bytes += value;
+    }
+
+    write(bytes, static_cast<std::uint16_t>(game.moves.size()));
+
+    ScratchBoard const scratch;
+
+    if (!load_fen(start_fen(game)))
+        return std::nullopt;
+
+    for (PackedMove const packed : game.moves) {
+        std::vector<Move> const moves = legal_moves();
+        auto const found = std::ranges::find(moves, packed.decode());
+
+        if (found == moves.end())
+            return std::nullopt;
+
+        write(bytes, static_cast<std::uint8_t>(found - moves.begin()));
+
+        play(*found);
+    }
+
+    return bytes;
+}
+
+auto decode_game(std::span<char const> const bytes)
+    -> std::optional<ArchivedGame> {
+    Cursor cursor{bytes};
+    ArchivedGame game;
+
+    std::optional<std::uint8_t> const tags = cursor.read<std::uint8_t>();
+
+    if (!tags)
+        return std::nullopt;
+
+    for (std::uint8_t tag = 0; tag < *tags; ++tag) {
+        std::optional<std::uint8_t> const key_size =
+            cursor.read<std::uint8_t>();
+        std::optional<std::string_view> const key =
+            key_size ? cursor.take(*key_size) : std::nullopt;
+        std::optional<std::uint16_t> const value_size =
+            key ? cursor.read<std::uint16_t>() : std::nullopt;
+        std::optional<std::string_view> const value =
+            value_size ? cursor.take(*value_size) : std::nullopt;
+
+        if (!value)
+            return std::nullopt;
+
+        game.tags.emplace_back(*key, *value);
+    }
+
+    std::optional<std::uint16_t> const plies = cursor.read<std::uint16_t>();
+    std::optional<std::string_view> const indices =
+        plies ? cursor.take(*plies) : std::nullopt;
+
+    if (!indices)
+        return std::nullopt;
+
+    ScratchBoard const scratch;
+
+    if (!load_fen(start_fen(game)))
+        return std::nullopt;
+
+    game.moves.reserve(*plies);
+
+    for (char const index : *indices) {
+        std::vector<Move> const moves = legal_moves();
+        auto const position = static_cast<std::uint8_t>(index);
+
+        if (position >= moves.size())
+            return std::nullopt;
+
+        game.moves.push_back(PackedMove::encode(moves[position]));
+
+        play(moves[position]);
+    }
+
+    return game;
+}
+
+ArchiveReader::~ArchiveReader() { munmap(this->mapping, this->length); }
+
+auto ArchiveReader::open(char const *path) -> ArchiveReader * {
+    std::int32_t const fd = ::open(path, O_RDONLY);
+
+    if (fd < 0)
+        return nullptr;
+
+    struct stat status{};
+
+    if (fstat(fd, &status) != 0 ||
+        static_cast<std::size_t>(status.st_size) < sizeof(Header)) {
+        close(fd);
+
+        return nullptr;
+    }
+
+    auto const length = static_cast<std::size_t>(status.st_size);
+
+    void *mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+        return nullptr;
+
+    auto const *bytes = static_cast<char const *>(mapping);
+
+    Header header;
+    std::memcpy(&header, bytes, sizeof(Header));
+
+    if (!valid(header, length)) {
+        munmap(mapping, length);
+
+        return nullptr;
+    }
+
+    madvise(mapping, length, MADV_RANDOM);
+
+    auto *reader = new ArchiveReader;
+
+    reader->mapping = mapping;
+    reader->length = length;
+    reader->offsets =
+        reinterpret_cast<std::uint64_t const *>(bytes + header.index);
+    reader->count = header.count;
+    reader->index = header.index;
+
+    return reader;
+}
+
+auto ArchiveReader::size() const -> std::size_t { return this->count; }
+
+auto ArchiveReader::game(std::size_t const index) const
+    -> std::optional<ArchivedGame> {
+    if (index >= this->count)
+        return std::nullopt;
+
+    std::uint64_t const begin = this->offsets[index];
+    std::uint64_t const end =
+        index + 1 < this->count ? this->offsets[index + 1] : this->index;
+
+    if (begin < sizeof(Header) || begin > end || end > this->index)
+        return std::nullopt;
+
+    return decode_game(
+        {static_cast<char const *>(this->mapping) + begin, end - begin}
+    );
+}
+
+auto ArchiveReader::games(std::int32_t const threads) const
+    -> std::vector<std::optional<ArchivedGame>> {
+    std::vector<std::optional<ArchivedGame>> games(this->count);
+    std::atomic<std::size_t> next = 0;
+
+    madvise(this->mapping, this->length, MADV_WILLNEED);
+
+    std::vector<std::thread> workers;
+
+    for (std::int32_t i = 0; i < std::max(threads, 1); ++i)
+        workers.emplace_back([this, &games, &next]() -> void {
+            for (std::size_t index = next++; index < games.size();
+                 index = next++)
+                games[index] = this->game(index);
+
+            clear_board();
+        });
+
+    for (std::thread &worker : workers)
+        worker.join();
+
+    return games;
+}
+
+ArchiveWriter::~ArchiveWriter() { (void)this->finish(); }
+
+auto ArchiveWriter::finish() -> bool {
+    if (this->fd < 0)
+        return false;
+
+    std::uint64_t const index = (this->end + alignof(std::uint64_t) - 1) &
+                                ~(alignof(std::uint64_t) - 1);
+
+    std::string bytes(index - this->end, '\0');
+
+    for (std::uint64_t const offset : this->offsets)
+        write(bytes, offset);
+
+    Header const header{.count = this->offsets.size(), .index = index};
+
+    bool const written =
+        pwrite(
+            this->fd, bytes.data(), bytes.size(), static_cast<off_t>(this->end)
+        ) == static_cast<ssize_t>(bytes.size()) &&
+        pwrite(this->fd, &header, sizeof(Header), 0) ==
+            static_cast<ssize_t>(sizeof(Header));
+
+    close(this->fd);
+
+    this->fd = -1;
+
+    return written;
+}
+
+auto ArchiveWriter::open(char const *path) -> ArchiveWriter * {
+    std::int32_t const fd = ::open(path, O_RDWR | O_CREAT, 0644);
+
+    if (fd < 0)
+        return nullptr;
+
+    struct stat status{};
+
+    if (fstat(fd, &status) != 0) {
+        close(fd);
+
+        return nullptr;
+    }
+
+    auto const length = static_cast<std::size_t>(status.st_size);
+
+    Header header;
+
+    if (length &&
+        (pread(fd, &header, sizeof(Header), 0) !=
+             static_cast<ssize_t>(sizeof(Header)) ||
+         !valid(header, length))) {
+        close(fd);
+
+        return nullptr;
+    }
+
+    std::vector<std::uint64_t> offsets(header.count);
+
+    std::size_t const size = offsets.size() * sizeof(std::uint64_t);
+
+    if (pread(fd, offsets.data(), size, static_cast<off_t>(header.index)) !=
+        static_cast<ssize_t>(size)) {
+        close(fd);
+
+        return nullptr;
+    }
+
+    auto *writer = new ArchiveWriter;
+
+    writer->fd = fd;
+    writer->end = header.index;
+    writer->offsets = std::move(offsets);
+
+    return writer;
+}
+
+auto ArchiveWriter::append(ArchivedGame const &game) -> bool {
+    std::optional<std::string> const bytes = encode_game(game);
+
+    if (!bytes || pwrite(
+                      this->fd, bytes->data(), bytes->size(),
+                      static_cast<off_t>(this->end)
+                  ) != static_cast<ssize_t>(bytes->size()))
+        return false;
+
+    this->offsets.push_back(this->end);
+    this->end += bytes->size();
+
+    return true;
+}
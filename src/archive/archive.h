@@ -0,0 +1,78 @@
+#ifndef ARCHIVE_H
+#define ARCHIVE_H
+
+#include "../move/move.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+struct ArchivedGame final {
+    std::vector<std::pair<std::string, std::string>> tags;
+    std::vector<PackedMove> moves;
+
+    [[nodiscard]] auto tag(std::string_view key) const -> std::string_view;
+};
+
+[[nodiscard]] auto encode_game(ArchivedGame const &game)
+    -> std::optional<std::string>;
+
+[[nodiscard]] auto decode_game(std::span<char const> bytes)
+    -> std::optional<ArchivedGame>;
+
+class ArchiveReader final {
+  public:
+    ArchiveReader(ArchiveReader const &) = delete;
+
+    auto operator=(ArchiveReader const &) -> ArchiveReader & = delete;
+
+    ~ArchiveReader();
+
+    [[nodiscard]] static auto open(char const *path) -> ArchiveReader *;
+
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    [[nodiscard]] auto game(std::size_t index) const
+        -> std::optional<ArchivedGame>;
+
+    [[nodiscard]] auto games(std::int32_t threads) const
+        -> std::vector<std::optional<ArchivedGame>>;
+
+  private:
+    void *mapping = nullptr;
+    std::size_t length = 0;
+    std::uint64_t const *offsets = nullptr;
+    std::size_t count = 0;
+    std::uint64_t index = 0;
+
+    ArchiveReader() = default;
+};
+
+class ArchiveWriter final {
+  public:
+    ArchiveWriter(ArchiveWriter const &) = delete;
+
+    auto operator=(ArchiveWriter const &) -> ArchiveWriter & = delete;
+
+    ~ArchiveWriter();
+
+    [[nodiscard]] static auto open(char const *path) -> ArchiveWriter *;
+
+    auto append(ArchivedGame const &game) -> bool;
+
+    [[nodiscard]] auto finish() -> bool;
+
+  private:
+    std::int32_t fd = -1;
+    std::uint64_t end = 0;
+    std::vector<std::uint64_t> offsets;
+
+    ArchiveWriter() = default;
+};
+
+#endif // ARCHIVE_H
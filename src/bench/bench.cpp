@@ -0,0 +1,90 @@
+#include "bench.h"
+
+#include "../stats/stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+
+auto allocation_count() -> std::uint64_t {
+    return thread_counters()[static_cast<std::size_t>(Counter::allocations)];
+}
+
+auto summarise(std::string name, std::vector<Measurement> const &measurements)
+    -> Statistics {
+    std::vector<double> per_op;
+
+    std::uint64_t operations = 0;
+    std::uint64_t allocations = 0;
+    std::chrono::nanoseconds elapsed{};
+
+    for (Measurement const &measurement : measurements) {
+        if (!measurement.operations)
+            continue;
+
+        operations += measurement.operations;
+        allocations += measurement.allocations;
+        elapsed += measurement.elapsed;
+
+        per_op.push_back(
+            static_cast<double>(measurement.elapsed.count()) /
+            static_cast<double>(measurement.operations)
+        );
+    }
+
+    std::ranges::sort(per_op);
+
+    auto const percentile = [&per_op](double const fraction) -> double {
+        if (per_op.empty())
+            return 0;
+
+        auto const index = static_cast<std::size_t>(
+            std::ceil(fraction * static_cast<double>(per_op.size())) - 1
+        );
+
+        return per_op[std::min(index, per_op.size() - 1)];
+    };
+
+    double const count = static_cast<double>(std::max<std::uint64_t>(
+        operations, 1
+    ));
+
+    return {
+        .name = std::move(name),
+        .operations = operations,
+        .ns_per_op = static_cast<double>(elapsed.count()) / count,
+        .allocations_per_op = static_cast<double>(allocations) / count,
+        .min = per_op.empty() ? 0 : per_op.front(),
+        .p50 = percentile(0.5),
+        .p90 = percentile(0.9),
+        .p99 = percentile(0.99),
+        .max = per_op.empty() ? 0 : per_op.back(),
+    };
+}
+
+auto to_json(
+    std::vector<Statistics> const &results, std::int32_t const samples,
+    std::size_t const positions
+) -> std::string {
+    std::string json = std::format(
+        "{{\n  \"samples\": {},\n  \"positions\": {},\n  "
+        "\"allocations_counted\": {},\n  \"benchmarks\": [",
+        samples, positions, counters_enabled()
+    );
+
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        Statistics const &result = results[i];
+
+        json += std::format(
+            "{}\n    {{\"name\": \"{}\", \"operations\": {}, "
+            "\"ns_per_op\": {:.2f}, \"allocations_per_op\": {:.3f}, "
+            "\"min_ns\": {:.2f}, \"p50_ns\": {:.2f}, \"p90_ns\": {:.2f}, "
+            "\"p99_ns\": {:.2f}, \"max_ns\": {:.2f}}}",
+            i ? "," : "", result.name, result.operations, result.ns_per_op,
+            result.allocations_per_op, result.min, result.p50, result.p90,
+            result.p99, result.max
+        );
+    }
+
+    return json + "\n  ]\n}\n";
+}
@@ -0,0 +1,54 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct Measurement final {
+    std::uint64_t operations;
+    std::chrono::nanoseconds elapsed;
+    std::uint64_t allocations;
+};
+
+struct Statistics final {
+    std::string name;
+    std::uint64_t operations;
+    double ns_per_op;
+    double allocations_per_op;
+    double min;
+    double p50;
+    double p90;
+    double p99;
+    double max;
+};
+
+[[nodiscard]] auto allocation_count() -> std::uint64_t;
+
+template <typename T> void keep(T const &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <typename Operation>
+[[nodiscard]] auto measure(Operation const &operation) -> Measurement {
+    std::uint64_t const allocations = allocation_count();
+    auto const start = std::chrono::steady_clock::now();
+
+    std::uint64_t const operations = operation();
+
+    auto const end = std::chrono::steady_clock::now();
+
+    return {operations, end - start, allocation_count() - allocations};
+}
+
+[[nodiscard]] auto summarise(
+    std::string name, std::vector<Measurement> const &measurements
+) -> Statistics;
+
+[[nodiscard]] auto to_json(
+    std::vector<Statistics> const &results, std::int32_t samples,
+    std::size_t positions
+) -> std::string;
+
+#endif // BENCH_H
@@ -0,0 +1,220 @@
+#include "bench/bench.h"
+#include "board/board.h"
+#include "pieces/pieces.h"
+#include "search/picker.h"
+#include "vars.h"
+
+#include <array>
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+static std::array<std::string_view, 8> constexpr k_corpus{
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "r1bq1rk1/pp2nppp/2n1p3/3pP3/1b1P4/2NB1N2/PP3PPP/R1BQK2R b KQ - 3 9",
+    "8/5pk1/6p1/3R4/1r5P/6P1/5PK1/8 b - - 2 41",
+};
+
+static std::int32_t constexpr k_repetitions = 16;
+
+template <typename Number>
+static auto parse(std::string_view const text, Number &number) -> bool {
+    auto const [end, error] =
+        std::from_chars(text.data(), text.data() + text.size(), number);
+
+    return error == std::errc{} && end == text.data() + text.size();
+}
+
+static auto run(
+    std::string name, std::int32_t const samples, auto const &prepare,
+    auto const &operation
+) -> Statistics {
+    std::vector<Measurement> measurements;
+
+    for (std::int32_t sample = 0; sample < samples; ++sample) {
+        for (std::string_view const fen : k_corpus) {
+            (void)load_fen(fen);
+
+            prepare();
+
+            measurements.push_back(measure([&operation]() -> std::uint64_t {
+                std::uint64_t operations = 0;
+
+                for (std::int32_t i = 0; i < k_repetitions; ++i)
+                    operations += operation();
+
+                return operations;
+            }));
+        }
+    }
+
+    clear_board();
+
+    return summarise(std::move(name), measurements);
+}
+
+std::int32_t main(std::int32_t argc, char *argv[]) {
+    std::int32_t samples = 50;
+    std::string_view filter;
+    char const *json = nullptr;
+
+    for (std::int32_t i = 1; i < argc; ++i) {
+        std::string_view const argument = argv[i];
+        bool parsed = i + 1 < argc;
+
+        if (argument == "--samples" && parsed) {
+            parsed = parse(argv[++i], samples) && samples > 0;
+        } else if (argument == "--filter" && parsed) {
+            filter = argv[++i];
+        } else if (argument == "--json" && parsed) {
+            json = argv[++i];
+        } else {
+            parsed = false;
+        }
+
+        if (!parsed) {
+            std::cerr << "usage: chess_bench [--samples n] [--filter text] "
+                         "[--json file]\n";
+
+            return 1;
+        }
+    }
+
+    auto const nothing = []() -> void {};
+
+    std::vector<Statistics> results;
+
+    auto const add = [&](std::string name, auto const &prepare,
+                         auto const &operation) -> void {
+        if (!name.contains(filter))
+            return;
+
+        results.push_back(run(std::move(name), samples, prepare, operation));
+    };
+
+    for (PieceType const type :
+         {PieceType::pawn, PieceType::knight, PieceType::bishop,
+          PieceType::rook, PieceType::queen, PieceType::king}) {
+        static std::array<std::string_view, 6> constexpr k_names{
+            "pawn", "knight", "bishop", "rook", "queen", "king",
+        };
+
+        std::string_view const name = k_names[static_cast<std::size_t>(type)];
+
+        add(std::format("get_moves/{}", name), nothing,
+            [type]() -> std::uint64_t {
+                std::uint64_t operations = 0;
+
+                for (Square const square : k_squares) {
+                    Piece *piece = k_pieces[square];
+
+                    if (!piece || piece->colour != k_current_player ||
+                        piece->type() != type)
+                        continue;
+
+                    keep(piece->get_moves(square).size());
+
+                    ++operations;
+                }
+
+                return operations;
+            });
+    }
+
+    add("is_checked", nothing, []() -> std::uint64_t {
+        std::size_t const colour = static_cast<std::size_t>(k_current_player);
+
+        keep(dynamic_cast<King *>(k_pieces[k_king_pos[colour]])->is_checked());
+
+        return 1;
+    });
+
+    std::vector<Move> candidates;
+
+    add(
+        "is_valid",
+        [&candidates]() -> void { candidates = legal_moves(); },
+        [&candidates]() -> std::uint64_t {
+            for (Move const &move : candidates)
+                keep(move.is_valid());
+
+            return candidates.size();
+        }
+    );
+
+    add("post_move_scan", nothing, []() -> std::uint64_t {
+        keep(in_check());
+        keep(has_legal_moves());
+
+        return 1;
+    });
+
+    static History constexpr empty_history{};
+
+    add("staged/first", nothing, []() -> std::uint64_t {
+        for (Move const &move : staged_moves({}, {}, empty_history)) {
+            keep(move.end);
+
+            break;
+        }
+
+        return 1;
+    });
+
+    add("staged/all", nothing, []() -> std::uint64_t {
+        std::uint64_t operations = 0;
+
+        for (Move const &move : staged_moves({}, {}, empty_history)) {
+            keep(move.end);
+
+            ++operations;
+        }
+
+        return operations;
+    });
+
+    add("picker/all", nothing, []() -> std::uint64_t {
+        std::uint64_t operations = 0;
+
+        for (Move const &move : MovePicker({}, {}, empty_history)) {
+            keep(move.end);
+
+            ++operations;
+        }
+
+        return operations;
+    });
+
+    std::cout << std::format(
+        "{:<20}{:>12}{:>12}{:>12}{:>12}{:>12}\n", "benchmark", "ns/op",
+        "allocs/op", "p50", "p90", "p99"
+    );
+
+    for (Statistics const &result : results)
+        std::cout << std::format(
+            "{:<20}{:>12.1f}{:>12.2f}{:>12.1f}{:>12.1f}{:>12.1f}\n",
+            result.name, result.ns_per_op, result.allocations_per_op,
+            result.p50, result.p90, result.p99
+        );
+
+    if (json) {
+        std::ofstream file(json);
+
+        file << to_json(results, samples, k_corpus.size());
+
+        if (!file) {
+            std::cerr << std::format("cannot write {}\n", json);
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
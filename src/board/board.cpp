@@ -0,0 +1,587 @@
+#include "board.h"
+
+#include "../pieces/pieces.h"
+#include "../stats/trace.h"
+#include "../vars.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <format>
+#include <ranges>
+#include <set>
+#include <utility>
+
+static std::string_view constexpr k_piece_letters = "pnbrqk";
+
+void clear_board() {
+    for (Piece *&piece : k_pieces) {
+        delete piece;
+
+        piece = nullptr;
+    }
+
+    k_king_pos = {k_board[7][4], k_board[0][4]};
+
+    k_current_player = Colour::white;
+
+    k_evaluation = {};
+    k_accumulator = {};
+    k_hash = 0;
+    k_pawn_hash = 0;
+    k_history.clear();
+    k_halfmove_clock = 0;
+    k_fullmove_number = 1;
+}
+
+ScratchBoard::ScratchBoard()
+    : pieces(std::exchange(k_pieces, {})), king_pos(k_king_pos),
+      current_player(k_current_player), evaluation(k_evaluation),
+      accumulator(k_accumulator), hash(k_hash), pawn_hash(k_pawn_hash),
+      history(std::move(k_history)), halfmove_clock(k_halfmove_clock),
+      fullmove_number(k_fullmove_number) {
+    clear_board();
+}
+
+ScratchBoard::~ScratchBoard() {
+    clear_board();
+
+    k_pieces = this->pieces;
+    k_king_pos = this->king_pos;
+    k_current_player = this->current_player;
+    k_evaluation = this->evaluation;
+    k_accumulator = this->accumulator;
+    k_hash = this->hash;
+    k_pawn_hash = this->pawn_hash;
+    k_history = std::move(this->history);
+    k_halfmove_clock = this->halfmove_clock;
+    k_fullmove_number = this->fullmove_number;
+}
+
+auto load_fen(std::string_view const fen) -> bool {
+    std::vector<std::string_view> const fields =
+        fen | std::views::split(' ') |
+        std::views::transform([](auto const &field) -> std::string_view {
+            return {field.begin(), field.end()};
+        }) |
+        std::views::filter([](std::string_view const field) -> bool {
+            return !field.empty();
+        }) |
+        std::ranges::to<std::vector>();
+
+    if (fields.size() < 4)
+        return false;
+
+    clear_board();
+
+    std::array<std::int32_t, 2> kings{};
+
+    Rank rank = 0;
+    File file = 0;
+
+    for (char const c : fields[0]) {
+        if (c == '/') {
+            ++rank;
+            file = 0;
+
+            continue;
+        }
+
+        if (c >= '1' && c <= '8') {
+            file += c - '0';
+
+            continue;
+        }
+
+        std::size_t const type = k_piece_letters.find(
+            static_cast<char>(std::tolower(static_cast<unsigned char>(c)))
+        );
+
+        if (type == std::string_view::npos || rank > 7 || file > 7) {
+            clear_board();
+
+            return false;
+        }
+
+        Colour const colour = std::isupper(static_cast<unsigned char>(c))
+                                  ? Colour::white
+                                  : Colour::black;
+
+        Piece *piece = Piece::create(static_cast<PieceType>(type), colour);
+
+        k_pieces[k_board[rank][file]] = piece;
+
+        if (auto *pawn = dynamic_cast<Pawn *>(piece))
+            pawn->moved = rank != (colour == Colour::white ? 6 : 1);
+        else if (auto *rook = dynamic_cast<Rook *>(piece))
+            rook->can_castle = false;
+        else if (auto *king = dynamic_cast<King *>(piece)) {
+            king->moved = true;
+
+            k_king_pos[static_cast<std::size_t>(colour)] = k_board[rank][file];
+
+            ++kings[static_cast<std::size_t>(colour)];
+        }
+
+        ++file;
+    }
+
+    if (kings[0] != 1 || kings[1] != 1 ||
+        (fields[1] != "w" && fields[1] != "b")) {
+        clear_board();
+
+        return false;
+    }
+
+    k_current_player = fields[1] == "w" ? Colour::white : Colour::black;
+
+    for (char const c : fields[2]) {
+        Colour const colour = std::isupper(static_cast<unsigned char>(c))
+                                  ? Colour::white
+                                  : Colour::black;
+        Rank const back_rank = colour == Colour::white ? 7 : 0;
+
+        File rook_file;
+
+        if (c == 'K' || c == 'k')
+            rook_file = 7;
+        else if (c == 'Q' || c == 'q')
+            rook_file = 0;
+        else
+            continue;
+
+        auto *king = dynamic_cast<King *>(k_pieces[k_board[back_rank][4]]);
+        auto *rook =
+            dynamic_cast<Rook *>(k_pieces[k_board[back_rank][rook_file]]);
+
+        if (!king || king->colour != colour || !rook || rook->colour != colour)
+            continue;
+
+        king->moved = false;
+        rook->can_castle = true;
+    }
+
+    if (fields[3].size() == 2 && fields[3][0] >= 'a' && fields[3][0] <= 'h') {
+        Rank const pawn_rank = k_current_player == Colour::white ? 3 : 4;
+
+        if (auto *pawn = dynamic_cast<Pawn *>(
+                k_pieces[k_board[pawn_rank][fields[3][0] - 'a']]
+            );
+            pawn && pawn->colour != k_current_player)
+            pawn->can_be_en_passanted = true;
+    }
+
+    if (fields.size() > 4)
+        std::from_chars(
+            fields[4].data(), fields[4].data() + fields[4].size(),
+            k_halfmove_clock
+        );
+
+    if (fields.size() > 5)
+        std::from_chars(
+            fields[5].data(), fields[5].data() + fields[5].size(),
+            k_fullmove_number
+        );
+
+    k_evaluation = Evaluation::compute();
+    k_hash = compute_hash();
+    k_pawn_hash = compute_pawn_hash();
+
+    return true;
+}
+
+auto fen() -> std::string {
+    std::string fen;
+
+    for (std::array<Square, 8> const &rank : k_board) {
+        std::int32_t empty = 0;
+
+        for (Square const &square : rank) {
+            Piece const *piece = k_pieces[square];
+
+            if (!piece) {
+                ++empty;
+
+                continue;
+            }
+
+            if (empty)
+                fen += static_cast<char>('0' + empty);
+
+            empty = 0;
+
+            char const letter =
+                k_piece_letters[static_cast<std::size_t>(piece->type())];
+
+            fen += piece->colour == Colour::white
+                       ? static_cast<char>(std::toupper(letter))
+                       : letter;
+        }
+
+        if (empty)
+            fen += static_cast<char>('0' + empty);
+
+        if (&rank != &k_board.back())
+            fen += '/';
+    }
+
+    fen += k_current_player == Colour::white ? " w " : " b ";
+
+    std::uint32_t const rights = castling_rights();
+
+    if (!rights)
+        fen += '-';
+
+    for (std::uint32_t bit = 0; bit < 4; ++bit)
+        if (rights & 1 << bit)
+            fen += "KQkq"[bit];
+
+    if (std::int32_t const file = en_passant_file(); file >= 0)
+        fen += std::format(
+            " {}{}", static_cast<char>('a' + file),
+            k_current_player == Colour::white ? 6 : 3
+        );
+    else
+        fen += " -";
+
+    return fen + std::format(" {} {}", k_halfmove_clock, k_fullmove_number);
+}
+
+auto castling_rights() -> std::uint32_t {
+    std::uint32_t rights = 0;
+
+    for (std::uint32_t bit = 0;
+         Square const square :
+         std::array{Square{7, 7}, Square{7, 0}, Square{0, 7}, Square{0, 0}}) {
+        Colour const colour =
+            square.rank() == 7 ? Colour::white : Colour::black;
+
+        auto const *king =
+            dynamic_cast<King *>(k_pieces[k_board[square.rank()][4]]);
+        auto const *rook = dynamic_cast<Rook *>(k_pieces[square]);
+
+        if (king && king->colour == colour && !king->moved && rook &&
+            rook->colour == colour && rook->can_castle)
+            rights |= 1 << bit;
+
+        ++bit;
+    }
+
+    return rights;
+}
+
+auto en_passant_file() -> std::int32_t {
+    for (Square const &square :
+         k_board[k_current_player == Colour::white ? 3 : 4])
+        if (auto const *pawn = dynamic_cast<Pawn *>(k_pieces[square]);
+            pawn && pawn->colour != k_current_player &&
+            pawn->can_be_en_passanted)
+            return square.file();
+
+    return -1;
+}
+
+auto compute_hash() -> Hash {
+    Hash hash = k_zobrist.castling[castling_rights()];
+
+    for (Square const square : k_squares)
+        if (Piece const *piece = k_pieces[square])
+            hash ^= k_zobrist.pieces[static_cast<std::size_t>(piece->colour)]
+                                    [static_cast<std::size_t>(piece->type())]
+                                    [square];
+
+    if (std::int32_t const file = en_passant_file(); file >= 0)
+        hash ^= k_zobrist.en_passant[file];
+
+    if (k_current_player == Colour::black)
+        hash ^= k_zobrist.side;
+
+    return hash;
+}
+
+auto compute_pawn_hash() -> Hash {
+    Hash hash = 0;
+
+    for (Square const square : k_squares)
+        if (Piece const *piece = k_pieces[square];
+            piece && typeid(*piece) == typeid(Pawn))
+            hash ^= k_zobrist.pieces[static_cast<std::size_t>(piece->colour)]
+                                    [static_cast<std::size_t>(PieceType::pawn)]
+                                    [square];
+
+    return hash;
+}
+
+template <Colour Us> static auto generate() -> std::vector<Move> {
+    std::vector<Move> moves;
+
+    for (Square const square : k_squares) {
+        Piece *piece = k_pieces[square];
+
+        if (!piece || piece->colour != Us)
+            continue;
+
+        std::set<Move> const piece_moves =
+            piece->type() == PieceType::pawn
+                ? static_cast<Pawn *>(piece)->get_moves<Us>(square)
+            : piece->type() == PieceType::king
+                ? static_cast<King *>(piece)->get_moves<Us>(square)
+                : piece->get_moves(square);
+
+        for (Move const &move : piece_moves) {
+            if (piece->type() != PieceType::pawn ||
+                move.end.rank() != k_back_rank<k_opponent<Us>>) {
+                moves.push_back(move);
+
+                continue;
+            }
+
+            for (PieceType const type :
+                 {PieceType::queen, PieceType::rook, PieceType::bishop,
+                  PieceType::knight})
+                moves.push_back({move.start, move.end, type});
+        }
+    }
+
+    return moves;
+}
+
+auto legal_moves() -> std::vector<Move> {
+    return k_current_player == Colour::white ? generate<Colour::white>()
+                                             : generate<Colour::black>();
+}
+
+static std::array<std::pair<Rank, File>, 4> constexpr k_straight{{
+    {-1, 0}, {1, 0}, {0, -1}, {0, 1},
+}};
+static std::array<std::pair<Rank, File>, 4> constexpr k_diagonal{{
+    {-1, -1}, {-1, 1}, {1, -1}, {1, 1},
+}};
+
+template <Colour Us>
+static void push_pawn(Move const &move, std::vector<Move> &moves) {
+    if (move.end.rank() != k_back_rank<k_opponent<Us>>) {
+        moves.push_back(move);
+
+        return;
+    }
+
+    for (PieceType const type :
+         {PieceType::queen, PieceType::rook, PieceType::bishop,
+          PieceType::knight})
+        moves.push_back({move.start, move.end, type});
+}
+
+template <Colour Us, bool Captures>
+static void slide(
+    Square const &start,
+    std::array<std::pair<Rank, File>, 4> const &directions,
+    std::vector<Move> &moves
+) {
+    for (auto const &[rank_step, file_step] : directions) {
+        Rank rank = start.rank() + rank_step;
+        File file = start.file() + file_step;
+
+        for (; rank >= 0 && rank < 8 && file >= 0 && file < 8;
+             rank += rank_step, file += file_step) {
+            Square const &square = k_board[rank][file];
+
+            if (Piece const *piece = k_pieces[square]) {
+                if (Captures && piece->colour != Us)
+                    moves.push_back({start, square});
+
+                break;
+            }
+
+            if (!Captures)
+                moves.push_back({start, square});
+        }
+    }
+}
+
+template <Colour Us, bool Captures>
+static void jump(
+    Square const &start, Attacks const &targets, std::vector<Move> &moves
+) {
+    for (Square const &square : targets)
+        if (Piece const *piece = k_pieces[square];
+            Captures ? piece && piece->colour != Us : !piece)
+            moves.push_back({start, square});
+}
+
+template <Colour Us, bool Captures>
+static void pawn_moves(Square const &start, std::vector<Move> &moves) {
+    static Rank constexpr start_rank = k_back_rank<Us> + k_forward<Us>;
+    static Rank constexpr last_rank = k_back_rank<k_opponent<Us>>;
+
+    Rank const ahead = start.rank() + k_forward<Us>;
+    bool const open =
+        ahead >= 0 && ahead < 8 && !k_pieces[k_board[ahead][start.file()]];
+
+    if (!Captures) {
+        if (!open || ahead == last_rank)
+            return;
+
+        moves.push_back({start, k_board[ahead][start.file()]});
+
+        if (start.rank() != start_rank)
+            return;
+
+        if (Square const &two_front =
+                k_board[ahead + k_forward<Us>][start.file()];
+            !k_pieces[two_front])
+            moves.push_back({start, two_front});
+
+        return;
+    }
+
+    if (open && ahead == last_rank)
+        push_pawn<Us>({start, k_board[ahead][start.file()]}, moves);
+
+    for (Square const &square :
+         k_pawn_attacks[static_cast<std::size_t>(Us)][start]) {
+        Piece const *piece = k_pieces[square];
+        auto const *pawn = dynamic_cast<Pawn *>(
+            k_pieces[k_board[start.rank()][square.file()]]
+        );
+
+        if ((piece && piece->colour != Us) ||
+            (pawn && pawn->can_be_en_passanted && pawn->colour != Us))
+            push_pawn<Us>({start, square}, moves);
+    }
+}
+
+template <Colour Us, bool Captures>
+static auto pseudo_legal() -> std::vector<Move> {
+    std::vector<Move> moves;
+
+    for (Square const square : k_squares) {
+        Piece *piece = k_pieces[square];
+
+        if (!piece || piece->colour != Us)
+            continue;
+
+        switch (piece->type()) {
+        case PieceType::pawn:
+            pawn_moves<Us, Captures>(square, moves);
+            break;
+        case PieceType::knight:
+            jump<Us, Captures>(square, k_knight_attacks[square], moves);
+            break;
+        case PieceType::bishop:
+            slide<Us, Captures>(square, k_diagonal, moves);
+            break;
+        case PieceType::rook:
+            slide<Us, Captures>(square, k_straight, moves);
+            break;
+        case PieceType::queen:
+            slide<Us, Captures>(square, k_straight, moves);
+            slide<Us, Captures>(square, k_diagonal, moves);
+            break;
+        case PieceType::king:
+            for (Move const &move :
+                 static_cast<King *>(piece)->get_moves<Us>(square))
+                if (static_cast<bool>(k_pieces[move.end]) == Captures)
+                    moves.push_back(move);
+            break;
+        }
+    }
+
+    return moves;
+}
+
+auto capture_moves() -> std::vector<Move> {
+    return k_current_player == Colour::white
+               ? pseudo_legal<Colour::white, true>()
+               : pseudo_legal<Colour::black, true>();
+}
+
+auto quiet_moves() -> std::vector<Move> {
+    return k_current_player == Colour::white
+               ? pseudo_legal<Colour::white, false>()
+               : pseudo_legal<Colour::black, false>();
+}
+
+auto has_legal_moves() -> bool {
+    TraceSpan const span("has_legal_moves");
+
+    return std::ranges::any_of(k_squares, [](Square const square) -> bool {
+        Piece *piece = k_pieces[square];
+
+        return piece && piece->colour == k_current_player &&
+               !piece->get_moves(square).empty();
+    });
+}
+
+auto in_check() -> bool {
+    TraceSpan const span("in_check");
+
+    auto const *king = static_cast<King *>(
+        k_pieces[k_king_pos[static_cast<std::size_t>(k_current_player)]]
+    );
+
+    return k_current_player == Colour::white
+               ? king->is_checked<Colour::white>()
+               : king->is_checked<Colour::black>();
+}
+
+auto is_repetition(std::int32_t const count) -> bool {
+    auto const size = static_cast<std::int32_t>(k_history.size());
+
+    std::int32_t found = 0;
+
+    for (std::int32_t index = size - 2;
+         index >= std::max(0, size - k_halfmove_clock); index -= 2)
+        if (k_history[index] == k_hash && ++found >= count)
+            return true;
+
+    return false;
+}
+
+auto is_draw() -> bool {
+    if (k_halfmove_clock >= 100 || is_repetition(2))
+        return true;
+
+    if (k_evaluation.phase > 1)
+        return false;
+
+    return std::ranges::none_of(
+        k_pieces, [](Piece const *piece) -> bool {
+            return piece && piece->type() == PieceType::pawn;
+        }
+    );
+}
+
+auto is_promotion(Move const &move) -> bool {
+    Piece const *piece = k_pieces[move.start];
+
+    return piece && piece->type() == PieceType::pawn &&
+           (move.end.rank() == 0 || move.end.rank() == 7);
+}
+
+auto to_uci(Move const &move) -> std::string {
+    std::string text = static_cast<std::string>(move.start) +
+                       static_cast<std::string>(move.end);
+
+    if (is_promotion(move))
+        text += k_piece_letters[static_cast<std::size_t>(move.promotion)];
+
+    return text;
+}
+
+auto parse_uci(std::string_view const text) -> std::optional<Move> {
+    for (Move const &move : legal_moves())
+        if (to_uci(move) == text)
+            return move;
+
+    return std::nullopt;
+}
+
+void play(Move const &move) {
+    Undo const undo = move.make();
+
+    delete undo.captured;
+
+    if (undo.promoted)
+        delete undo.piece;
+}
@@ -0,0 +1,78 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include "../eval/eval.h"
+#include "../move/move.h"
+#include "../nnue/nnue.h"
+#include "zobrist.h"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+inline static std::string_view constexpr k_start_fen =
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+void clear_board();
+
+class ScratchBoard final {
+  public:
+    ScratchBoard();
+
+    ScratchBoard(ScratchBoard const &) = delete;
+
+    auto operator=(ScratchBoard const &) -> ScratchBoard & = delete;
+
+    ~ScratchBoard();
+
+  private:
+    std::array<Piece *, 64> pieces;
+    std::array<Square, 2> king_pos;
+    Colour current_player;
+    Evaluation evaluation;
+    Accumulator accumulator;
+    Hash hash;
+    Hash pawn_hash;
+    std::vector<Hash> history;
+    std::int32_t halfmove_clock;
+    std::int32_t fullmove_number;
+};
+
+[[nodiscard]] auto load_fen(std::string_view fen) -> bool;
+
+[[nodiscard]] auto fen() -> std::string;
+
+[[nodiscard]] auto castling_rights() -> std::uint32_t;
+
+[[nodiscard]] auto en_passant_file() -> std::int32_t;
+
+[[nodiscard]] auto compute_hash() -> Hash;
+
+[[nodiscard]] auto compute_pawn_hash() -> Hash;
+
+[[nodiscard]] auto legal_moves() -> std::vector<Move>;
+
+[[nodiscard]] auto capture_moves() -> std::vector<Move>;
+
+[[nodiscard]] auto quiet_moves() -> std::vector<Move>;
+
+[[nodiscard]] auto has_legal_moves() -> bool;
+
+[[nodiscard]] auto in_check() -> bool;
+
+[[nodiscard]] auto is_repetition(std::int32_t count) -> bool;
+
+[[nodiscard]] auto is_draw() -> bool;
+
+[[nodiscard]] auto is_promotion(Move const &move) -> bool;
+
+[[nodiscard]] auto to_uci(Move const &move) -> std::string;
+
+[[nodiscard]] auto parse_uci(std::string_view text) -> std::optional<Move>;
+
+void play(Move const &move);
+
+#endif // BOARD_H
@@ -0,0 +1,45 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <array>
+#include <cstdint>
+
+using Hash = std::uint64_t;
+
+struct Zobrist final {
+    std::array<std::array<std::array<Hash, 64>, 6>, 2> pieces;
+    std::array<Hash, 16> castling;
+    std::array<Hash, 8> en_passant;
+    Hash side;
+};
+
+inline static auto constexpr k_zobrist = [] -> Zobrist {
+    Zobrist zobrist{};
+
+    Hash state = 0x9E3779B97F4A7C15;
+
+    auto const next = [&state] -> Hash {
+        Hash value = state += 0x9E3779B97F4A7C15;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+
+        return value ^ (value >> 31);
+    };
+
+    for (auto &colour : zobrist.pieces)
+        for (auto &type : colour)
+            for (Hash &key : type)
+                key = next();
+
+    for (Hash &key : zobrist.castling)
+        key = next();
+
+    for (Hash &key : zobrist.en_passant)
+        key = next();
+
+    zobrist.side = next();
+
+    return zobrist;
+}();
+
+#endif // ZOBRIST_H
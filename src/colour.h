@@ -1,6 +1,18 @@
 #ifndef COLOUR_H
 #define COLOUR_H
 
+#include <cstdint>
+
 enum class Colour { white, black };
 
+template <Colour Us>
+inline static Colour constexpr k_opponent =
+    Us == Colour::white ? Colour::black : Colour::white;
+
+template <Colour Us>
+inline static std::int32_t constexpr k_back_rank = Us == Colour::white ? 7 : 0;
+
+template <Colour Us>
+inline static std::int32_t constexpr k_forward = Us == Colour::white ? -1 : 1;
+
 #endif
\ No newline at end of file
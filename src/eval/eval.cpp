@@ -0,0 +1,65 @@
+#include "eval.h"
+
+#include "../pieces/pieces.h"
+#include "../vars.h"
+
+#include <algorithm>
+
+static auto constexpr combine(
+    std::array<Score, 6> const &values, std::array<Table, 6> const &tables
+) -> std::array<std::array<Table, 6>, 2> {
+    std::array<std::array<Table, 6>, 2> combined{};
+
+    for (std::size_t type = 0; type < 6; ++type) {
+        for (std::size_t index = 0; index < 64; ++index) {
+            combined[0][type][index] = values[type] + tables[type][index];
+            combined[1][type][index] =
+                -(values[type] + tables[type][index ^ 56]);
+        }
+    }
+
+    return combined;
+}
+
+static std::array<std::array<Table, 6>, 2> constexpr k_middlegame =
+    combine(k_middlegame_values, k_middlegame_tables);
+static std::array<std::array<Table, 6>, 2> constexpr k_endgame =
+    combine(k_endgame_values, k_endgame_tables);
+
+void Evaluation::add(Piece const &piece, Square const &square) {
+    auto const colour = static_cast<std::size_t>(piece.colour);
+    auto const type = static_cast<std::size_t>(piece.type());
+
+    this->middlegame += k_middlegame[colour][type][square];
+    this->endgame += k_endgame[colour][type][square];
+    this->phase += k_phase_values[type];
+}
+
+void Evaluation::remove(Piece const &piece, Square const &square) {
+    auto const colour = static_cast<std::size_t>(piece.colour);
+    auto const type = static_cast<std::size_t>(piece.type());
+
+    this->middlegame -= k_middlegame[colour][type][square];
+    this->endgame -= k_endgame[colour][type][square];
+    this->phase -= k_phase_values[type];
+}
+
+auto Evaluation::score(Colour const colour) const -> Score {
+    std::int32_t const phase = std::min(this->phase, k_max_phase);
+
+    Score const score = (this->middlegame * phase +
+                         this->endgame * (k_max_phase - phase)) /
+                        k_max_phase;
+
+    return colour == Colour::white ? score : -score;
+}
+
+auto Evaluation::compute() -> Evaluation {
+    Evaluation evaluation;
+
+    for (Square const &square : k_squares)
+        if (Piece const *piece = k_pieces[square])
+            evaluation.add(*piece, square);
+
+    return evaluation;
+}
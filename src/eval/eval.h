@@ -0,0 +1,26 @@
+#ifndef EVAL_H
+#define EVAL_H
+
+#include "../colour.h"
+#include "../square.h"
+#include "tables.h"
+
+struct Piece;
+
+struct Evaluation final {
+    Score middlegame = 0;
+    Score endgame = 0;
+    std::int32_t phase = 0;
+
+    void add(Piece const &piece, Square const &square);
+
+    void remove(Piece const &piece, Square const &square);
+
+    [[nodiscard]] auto score(Colour colour) const -> Score;
+
+    [[nodiscard]] static auto compute() -> Evaluation;
+
+    [[nodiscard]] bool operator==(Evaluation const &) const = default;
+};
+
+#endif // EVAL_H
@@ -0,0 +1,217 @@
+#include "pawns.h"
+
+#include "../pieces/pieces.h"
+#include "../stats/stats.h"
+#include "../vars.h"
+#include "eval.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <typeinfo>
+
+struct Weight final {
+    Score middlegame = 0;
+    Score endgame = 0;
+};
+
+struct Spans final {
+    std::array<Bitboard, 64> front{};
+    std::array<Bitboard, 64> passed{};
+    std::array<Bitboard, 64> support{};
+    std::array<Bitboard, 64> stop_attackers{};
+    std::array<Bitboard, 64> near_shield{};
+    std::array<Bitboard, 64> far_shield{};
+};
+
+static std::size_t constexpr k_pawn_entries = std::size_t{1} << 14;
+
+static Weight constexpr k_doubled{-10, -25};
+static Weight constexpr k_isolated{-6, -15};
+static Weight constexpr k_backward{-8, -12};
+static std::array<Weight, 8> constexpr k_passed{{
+    {0, 0},
+    {5, 10},
+    {8, 15},
+    {15, 30},
+    {30, 55},
+    {50, 90},
+    {80, 150},
+    {0, 0},
+}};
+
+static Score constexpr k_near_shield = 12;
+static Score constexpr k_far_shield = 6;
+static Score constexpr k_their_king_distance = 5;
+static Score constexpr k_our_king_distance = 2;
+
+static auto constexpr bit(Rank const rank, File const file) -> Bitboard {
+    return rank >= 0 && rank < 8 && file >= 0 && file < 8
+               ? Bitboard{1} << Square(rank, file)
+               : 0;
+}
+
+static std::array<Bitboard, 8> constexpr k_adjacent_files = [] {
+    std::array<Bitboard, 8> adjacent{};
+
+    for (Square const &square : k_squares)
+        adjacent[square.file()] |= bit(square.rank(), square.file() - 1) |
+                                   bit(square.rank(), square.file() + 1);
+
+    return adjacent;
+}();
+
+static std::array<Spans, 2> constexpr k_spans = [] {
+    std::array<Spans, 2> spans{};
+
+    for (std::size_t side = 0; side < spans.size(); ++side) {
+        Rank const forward = side == 0 ? k_forward<Colour::white>
+                                       : k_forward<Colour::black>;
+
+        for (Square const &square : k_squares) {
+            Rank const rank = square.rank();
+            File const file = square.file();
+
+            for (Rank ahead = rank + forward; ahead >= 0 && ahead < 8;
+                 ahead += forward) {
+                spans[side].front[square] |= bit(ahead, file);
+                spans[side].passed[square] |= bit(ahead, file - 1) |
+                                              bit(ahead, file) |
+                                              bit(ahead, file + 1);
+            }
+
+            for (Rank behind = rank; behind >= 0 && behind < 8;
+                 behind -= forward)
+                spans[side].support[square] |=
+                    bit(behind, file - 1) | bit(behind, file + 1);
+
+            spans[side].stop_attackers[square] =
+                bit(rank + 2 * forward, file - 1) |
+                bit(rank + 2 * forward, file + 1);
+
+            for (File shield = file - 1; shield <= file + 1; ++shield) {
+                spans[side].near_shield[square] |= bit(rank + forward, shield);
+                spans[side].far_shield[square] |=
+                    bit(rank + 2 * forward, shield);
+            }
+        }
+    }
+
+    return spans;
+}();
+
+static thread_local PawnTable k_pawn_table{k_pawn_entries};
+
+static auto relative_rank(std::size_t const side, Square const &square)
+    -> Rank {
+    return side == 0 ? 7 - square.rank() : square.rank();
+}
+
+static auto distance(Square const &from, Square const &to) -> Score {
+    return std::max(
+        std::abs(from.rank() - to.rank()), std::abs(from.file() - to.file())
+    );
+}
+
+static void compute(PawnEntry &entry, Hash const key) {
+    entry = {.key = key};
+
+    for (Square const &square : k_squares)
+        if (Piece const *piece = k_pieces[square];
+            piece && typeid(*piece) == typeid(Pawn))
+            entry.pawns[static_cast<std::size_t>(piece->colour)] |=
+                Bitboard{1} << square;
+
+    for (std::size_t side = 0; side < entry.pawns.size(); ++side) {
+        Bitboard const ours = entry.pawns[side];
+        Bitboard const theirs = entry.pawns[side ^ 1];
+        Spans const &spans = k_spans[side];
+
+        Weight weight;
+
+        auto const add = [&weight](Weight const &term) -> void {
+            weight.middlegame += term.middlegame;
+            weight.endgame += term.endgame;
+        };
+
+        for (Bitboard remaining = ours; remaining; remaining &= remaining - 1) {
+            Square const square(
+                static_cast<std::size_t>(std::countr_zero(remaining))
+            );
+
+            if (ours & spans.front[square])
+                add(k_doubled);
+            else if (!(theirs & spans.passed[square])) {
+                entry.passed[side] |= Bitboard{1} << square;
+
+                add(k_passed[relative_rank(side, square)]);
+            }
+
+            if (!(ours & k_adjacent_files[square.file()]))
+                add(k_isolated);
+            else if (!(ours & spans.support[square]) &&
+                     (theirs & spans.stop_attackers[square]))
+                add(k_backward);
+        }
+
+        Score const sign = side == 0 ? 1 : -1;
+
+        entry.middlegame += sign * weight.middlegame;
+        entry.endgame += sign * weight.endgame;
+    }
+}
+
+PawnTable::PawnTable(std::size_t const entries)
+    : entries(std::make_unique<PawnEntry[]>(entries)), mask(entries - 1) {}
+
+auto PawnTable::probe(Hash const key) -> PawnEntry const & {
+    count(Counter::pawn_probes);
+
+    PawnEntry &entry = this->entries[key & this->mask];
+
+    if (entry.key == key)
+        count(Counter::pawn_hits);
+    else
+        compute(entry, key);
+
+    return entry;
+}
+
+auto pawn_structure(Colour const colour) -> Score {
+    PawnEntry const &entry = k_pawn_table.probe(k_pawn_hash);
+
+    Evaluation evaluation{
+        .middlegame = entry.middlegame,
+        .endgame = entry.endgame,
+        .phase = k_evaluation.phase,
+    };
+
+    for (std::size_t side = 0; side < entry.pawns.size(); ++side) {
+        Square const &king = k_king_pos[side];
+        Square const &their_king = k_king_pos[side ^ 1];
+        Spans const &spans = k_spans[side];
+        Score const sign = side == 0 ? 1 : -1;
+
+        evaluation.middlegame +=
+            sign *
+            (std::popcount(entry.pawns[side] & spans.near_shield[king]) *
+                 k_near_shield +
+             std::popcount(entry.pawns[side] & spans.far_shield[king]) *
+                 k_far_shield);
+
+        for (Bitboard remaining = entry.passed[side]; remaining;
+             remaining &= remaining - 1) {
+            Square const square(
+                static_cast<std::size_t>(std::countr_zero(remaining))
+            );
+
+            evaluation.endgame +=
+                sign *
+                (distance(their_king, square) * k_their_king_distance -
+                 distance(king, square) * k_our_king_distance) *
+                relative_rank(side, square) / 4;
+        }
+    }
+
+    return evaluation.score(colour);
+}
@@ -0,0 +1,36 @@
+#ifndef PAWNS_H
+#define PAWNS_H
+
+#include "../board/zobrist.h"
+#include "../colour.h"
+#include "tables.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+using Bitboard = std::uint64_t;
+
+struct PawnEntry final {
+    Hash key = 0;
+    std::array<Bitboard, 2> pawns{};
+    std::array<Bitboard, 2> passed{};
+    Score middlegame = 0;
+    Score endgame = 0;
+};
+
+class PawnTable final {
+  public:
+    explicit PawnTable(std::size_t entries);
+
+    [[nodiscard]] auto probe(Hash key) -> PawnEntry const &;
+
+  private:
+    std::unique_ptr<PawnEntry[]> entries;
+    std::size_t mask = 0;
+};
+
+[[nodiscard]] auto pawn_structure(Colour colour) -> Score;
+
+#endif // PAWNS_H
@@ -0,0 +1,423 @@
+#include "explorer.h"
+
+#include "../board/board.h"
+#include "../vars.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <format>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static std::array<char, 4> constexpr k_magic{'C', 'H', 'S', 'X'};
+static std::uint32_t constexpr k_version = 1;
+
+static std::size_t constexpr k_run_records = std::size_t{1} << 22;
+static std::size_t constexpr k_write_buffer = std::size_t{1} << 16;
+
+struct Header final {
+    std::array<char, 4> magic = k_magic;
+    std::uint32_t version = k_version;
+    std::uint64_t postings = 0;
+    std::uint64_t entries = 0;
+    std::uint64_t entries_offset = 0;
+};
+
+static_assert(sizeof(Header) == 32);
+
+enum class Outcome : std::uint8_t { unknown, white, draw, black };
+
+struct Record final {
+    Hash hash;
+    std::uint32_t game;
+    PackedMove move;
+    Outcome outcome;
+
+    [[nodiscard]] auto operator<(Record const &other) const -> bool {
+        return std::tie(this->hash, this->move.data, this->game) <
+               std::tie(other.hash, other.move.data, other.game);
+    }
+};
+
+static_assert(sizeof(Record) == 16);
+
+struct Run final {
+    Record const *records = nullptr;
+    std::size_t size = 0;
+    std::size_t length = 0;
+    void *mapping = nullptr;
+};
+
+template <typename T> struct Output final {
+    std::int32_t fd;
+    std::uint64_t offset;
+    std::vector<T> buffer{};
+    bool failed = false;
+
+    void push(T const &value) {
+        this->buffer.push_back(value);
+
+        if (this->buffer.size() >= k_write_buffer)
+            this->flush();
+    }
+
+    void flush() {
+        std::size_t const size = this->buffer.size() * sizeof(T);
+
+        if (pwrite(
+                this->fd, this->buffer.data(), size,
+                static_cast<off_t>(this->offset)
+            ) != static_cast<ssize_t>(size))
+            this->failed = true;
+
+        this->offset += size;
+        this->buffer.clear();
+    }
+};
+
+static auto outcome(ArchivedGame const &game) -> Outcome {
+    std::string_view const result = game.tag("Result");
+
+    return result == "1-0"       ? Outcome::white
+           : result == "0-1"     ? Outcome::black
+           : result == "1/2-1/2" ? Outcome::draw
+                                 : Outcome::unknown;
+}
+
+static auto spill(std::vector<Record> &records, std::string const &path)
+    -> bool {
+    std::sort(records.begin(), records.end());
+
+    std::int32_t const fd =
+        ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+
+    if (fd < 0)
+        return false;
+
+    std::size_t const size = records.size() * sizeof(Record);
+    bool const written =
+        write(fd, records.data(), size) == static_cast<ssize_t>(size);
+
+    close(fd);
+
+    records.clear();
+
+    return written;
+}
+
+static auto map_run(std::string const &path) -> std::optional<Run> {
+    std::int32_t const fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+        return std::nullopt;
+
+    struct stat status{};
+
+    if (fstat(fd, &status) != 0) {
+        close(fd);
+
+        return std::nullopt;
+    }
+
+    Run run{
+        .size = static_cast<std::size_t>(status.st_size) / sizeof(Record),
+        .length = static_cast<std::size_t>(status.st_size),
+    };
+
+    if (run.length) {
+        run.mapping =
+            mmap(nullptr, run.length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (run.mapping == MAP_FAILED) {
+            close(fd);
+
+            return std::nullopt;
+        }
+
+        madvise(run.mapping, run.length, MADV_SEQUENTIAL);
+
+        run.records = static_cast<Record const *>(run.mapping);
+    }
+
+    close(fd);
+
+    return run;
+}
+
+static auto merge(
+    std::vector<Run> const &runs, std::int32_t const fd,
+    std::uint64_t const postings, IndexSummary &summary
+) -> bool {
+    std::uint64_t const entries_offset =
+        sizeof(Header) +
+        (postings * sizeof(std::uint32_t) + alignof(ExplorerEntry) - 1) /
+            alignof(ExplorerEntry) * alignof(ExplorerEntry);
+
+    Output<std::uint32_t> games{.fd = fd, .offset = sizeof(Header)};
+    Output<ExplorerEntry> entries{.fd = fd, .offset = entries_offset};
+
+    using Cursor = std::pair<Record, std::size_t>;
+
+    auto const later = [](Cursor const &a, Cursor const &b) -> bool {
+        return b.first < a.first;
+    };
+
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(later)> queue(
+        later
+    );
+    std::vector<std::size_t> positions(runs.size());
+
+    for (std::size_t index = 0; index < runs.size(); ++index)
+        if (runs[index].size)
+            queue.emplace(runs[index].records[0], index);
+
+    ExplorerEntry entry;
+
+    while (!queue.empty()) {
+        auto const [record, index] = queue.top();
+
+        queue.pop();
+
+        if (++positions[index] < runs[index].size)
+            queue.emplace(runs[index].records[positions[index]], index);
+
+        if (entry.games &&
+            (entry.hash != record.hash || entry.move != record.move)) {
+            entries.push(entry);
+
+            entry.first += entry.games;
+            entry.games = entry.white = entry.draws = entry.black = 0;
+        }
+
+        entry.hash = record.hash;
+        entry.move = record.move;
+
+        ++entry.games;
+
+        if (record.outcome == Outcome::white)
+            ++entry.white;
+        else if (record.outcome == Outcome::draw)
+            ++entry.draws;
+        else if (record.outcome == Outcome::black)
+            ++entry.black;
+
+        games.push(record.game);
+    }
+
+    if (entry.games)
+        entries.push(entry);
+
+    games.flush();
+    entries.flush();
+
+    summary.entries =
+        (entries.offset - entries_offset) / sizeof(ExplorerEntry);
+
+    Header const header{
+        .postings = postings,
+        .entries = summary.entries,
+        .entries_offset = entries_offset,
+    };
+
+    return !games.failed && !entries.failed &&
+           pwrite(fd, &header, sizeof(Header), 0) ==
+               static_cast<ssize_t>(sizeof(Header));
+}
+
+auto build_index(
+    ArchiveReader const &archive, char const *path, std::int32_t const threads
+) -> std::optional<IndexSummary> {
+    IndexSummary summary{.games = archive.size()};
+
+    std::atomic<std::size_t> next = 0;
+    std::atomic<bool> failed = false;
+
+    std::mutex mutex;
+    std::vector<std::string> runs;
+
+    auto const spill_run = [&](std::vector<Record> &records) -> void {
+        std::string run;
+
+        {
+            std::lock_guard const lock(mutex);
+
+            run = std::format("{}.run{}", path, runs.size());
+            runs.push_back(run);
+            summary.positions += records.size();
+        }
+
+        if (!spill(records, run))
+            failed = true;
+    };
+
+    std::vector<std::thread> workers;
+
+    for (std::int32_t i = 0; i < std::max(threads, 1); ++i)
+        workers.emplace_back([&archive, &next, &failed, &spill_run]() -> void {
+            std::vector<Record> records;
+
+            records.reserve(k_run_records);
+
+            for (std::size_t index = next++; index < archive.size();
+                 index = next++) {
+                std::optional<ArchivedGame> const game = archive.game(index);
+
+                if (!game) {
+                    failed = true;
+
+                    continue;
+                }
+
+                std::string_view const fen = game->tag("FEN");
+
+                (void)load_fen(fen.empty() ? k_start_fen : fen);
+
+                Outcome const result = outcome(*game);
+
+                for (PackedMove const move : game->moves) {
+                    records.push_back({
+                        .hash = k_hash,
+                        .game = static_cast<std::uint32_t>(index),
+                        .move = move,
+                        .outcome = result,
+                    });
+
+                    play(move.decode());
+                }
+
+                if (records.size() >= k_run_records)
+                    spill_run(records);
+            }
+
+            if (!records.empty())
+                spill_run(records);
+
+            clear_board();
+        });
+
+    for (std::thread &worker : workers)
+        worker.join();
+
+    std::vector<Run> mapped;
+
+    for (std::string const &run : runs)
+        if (std::optional<Run> const mapping = map_run(run))
+            mapped.push_back(*mapping);
+        else
+            failed = true;
+
+    summary.runs = runs.size();
+
+    if (!failed) {
+        std::int32_t const fd =
+            ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (fd < 0 || !merge(mapped, fd, summary.positions, summary))
+            failed = true;
+
+        if (fd >= 0)
+            close(fd);
+    }
+
+    for (Run const &run : mapped)
+        if (run.mapping)
+            munmap(run.mapping, run.length);
+
+    for (std::string const &run : runs)
+        unlink(run.c_str());
+
+    if (failed)
+        return std::nullopt;
+
+    return summary;
+}
+
+Explorer::~Explorer() { munmap(this->mapping, this->length); }
+
+auto Explorer::open(char const *path) -> Explorer * {
+    std::int32_t const fd = ::open(path, O_RDONLY);
+
+    if (fd < 0)
+        return nullptr;
+
+    struct stat status{};
+
+    if (fstat(fd, &status) != 0 ||
+        static_cast<std::size_t>(status.st_size) < sizeof(Header)) {
+        close(fd);
+
+        return nullptr;
+    }
+
+    auto const length = static_cast<std::size_t>(status.st_size);
+
+    void *mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+        return nullptr;
+
+    auto const *bytes = static_cast<char const *>(mapping);
+
+    Header header;
+    std::memcpy(&header, bytes, sizeof(Header));
+
+    if (header.magic != k_magic || header.version != k_version ||
+        header.entries_offset % alignof(ExplorerEntry) != 0 ||
+        header.entries_offset > length ||
+        header.entries > (length - header.entries_offset) /
+                             sizeof(ExplorerEntry) ||
+        header.postings > (header.entries_offset - sizeof(Header)) /
+                              sizeof(std::uint32_t)) {
+        munmap(mapping, length);
+
+        return nullptr;
+    }
+
+    madvise(mapping, length, MADV_RANDOM);
+
+    auto *explorer = new Explorer;
+
+    explorer->mapping = mapping;
+    explorer->length = length;
+    explorer->entries = {
+        reinterpret_cast<ExplorerEntry const *>(bytes + header.entries_offset),
+        header.entries
+    };
+    explorer->postings = {
+        reinterpret_cast<std::uint32_t const *>(bytes + sizeof(Header)),
+        header.postings
+    };
+
+    return explorer;
+}
+
+auto Explorer::lookup(Hash const hash) const
+    -> std::span<ExplorerEntry const> {
+    auto const [first, last] = std::ranges::equal_range(
+        this->entries, hash, {}, &ExplorerEntry::hash
+    );
+
+    return {first, last};
+}
+
+auto Explorer::games(ExplorerEntry const &entry) const
+    -> std::span<std::uint32_t const> {
+    if (entry.first > this->postings.size() ||
+        entry.games > this->postings.size() - entry.first)
+        return {};
+
+    return this->postings.subspan(entry.first, entry.games);
+}
@@ -0,0 +1,62 @@
+#ifndef EXPLORER_H
+#define EXPLORER_H
+
+#include "../archive/archive.h"
+#include "../board/zobrist.h"
+#include "../move/move.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+struct ExplorerEntry final {
+    Hash hash = 0;
+    PackedMove move;
+    std::uint16_t reserved = 0;
+    std::uint32_t games = 0;
+    std::uint32_t white = 0;
+    std::uint32_t draws = 0;
+    std::uint32_t black = 0;
+    std::uint32_t first = 0;
+};
+
+static_assert(sizeof(ExplorerEntry) == 32);
+
+struct IndexSummary final {
+    std::uint64_t games = 0;
+    std::uint64_t positions = 0;
+    std::uint64_t entries = 0;
+    std::size_t runs = 0;
+};
+
+[[nodiscard]] auto build_index(
+    ArchiveReader const &archive, char const *path, std::int32_t threads
+) -> std::optional<IndexSummary>;
+
+class Explorer final {
+  public:
+    Explorer(Explorer const &) = delete;
+
+    auto operator=(Explorer const &) -> Explorer & = delete;
+
+    ~Explorer();
+
+    [[nodiscard]] static auto open(char const *path) -> Explorer *;
+
+    [[nodiscard]] auto lookup(Hash hash) const
+        -> std::span<ExplorerEntry const>;
+
+    [[nodiscard]] auto games(ExplorerEntry const &entry) const
+        -> std::span<std::uint32_t const>;
+
+  private:
+    void *mapping = nullptr;
+    std::size_t length = 0;
+    std::span<ExplorerEntry const> entries;
+    std::span<std::uint32_t const> postings;
+
+    Explorer() = default;
+};
+
+#endif // EXPLORER_H
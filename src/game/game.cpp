@@ -0,0 +1,169 @@
+#include "game.h"
+
+#include "../board/board.h"
+#include "../pieces/pieces.h"
+#include "../vars.h"
+
+#include <algorithm>
+
+GameTree::~GameTree() { this->discard(); }
+
+auto GameTree::reset(std::string_view const fen) -> bool {
+    this->discard();
+
+    if (!load_fen(fen))
+        return false;
+
+    this->nodes = {{.checkpoint = 0, .hash = k_hash}};
+    this->checkpoints = {std::string(fen)};
+    this->path = {0};
+    this->current = 0;
+
+    return true;
+}
+
+void GameTree::play(Move const &move) {
+    PackedMove const packed = PackedMove::encode(move);
+    std::uint32_t const parent = this->path[this->current];
+
+    std::uint32_t child = this->nodes[parent].child;
+
+    while (child != Node::k_none && this->nodes[child].move != packed)
+        child = this->nodes[child].sibling;
+
+    if (child == Node::k_none) {
+        child = static_cast<std::uint32_t>(this->nodes.size());
+
+        this->nodes.push_back({
+            .move = packed,
+            .ply = static_cast<std::uint16_t>(this->current + 1),
+            .parent = parent,
+            .sibling = this->nodes[parent].child,
+        });
+
+        this->nodes[parent].child = child;
+    }
+
+    this->nodes[parent].main = child;
+
+    this->path.resize(this->current + 1);
+    this->path.push_back(child);
+
+    this->advance();
+}
+
+auto GameTree::undo() -> bool {
+    if (!this->current)
+        return false;
+
+    this->jump(this->current - 1);
+
+    return true;
+}
+
+auto GameTree::redo() -> bool {
+    if (this->current + 1 == this->path.size()) {
+        std::uint32_t const main = this->nodes[this->path.back()].main;
+
+        if (main == Node::k_none)
+            return false;
+
+        this->path.push_back(main);
+    }
+
+    this->jump(this->current + 1);
+
+    return true;
+}
+
+void GameTree::jump(std::size_t const ply) {
+    std::size_t const target = std::min(ply, this->path.size() - 1);
+
+    if (target >= this->current &&
+        target - this->current <= k_checkpoint_interval) {
+        while (this->current < target)
+            this->advance();
+
+        return;
+    }
+
+    if (target < this->current &&
+        this->current - target <= k_checkpoint_interval &&
+        this->current - target <= this->undos.size()) {
+        while (this->current > target)
+            this->retreat();
+
+        return;
+    }
+
+    this->restore(target);
+}
+
+auto GameTree::ply() const -> std::size_t { return this->current; }
+
+auto GameTree::root() const -> std::string const & {
+    return this->checkpoints.front();
+}
+
+auto GameTree::line() const -> std::vector<std::uint32_t> const & {
+    return this->path;
+}
+
+auto GameTree::node(std::uint32_t const index) const -> Node const & {
+    return this->nodes[index];
+}
+
+void GameTree::advance() {
+    Node &node = this->nodes[this->path[++this->current]];
+
+    this->undos.push_back(node.move.decode().make());
+
+    node.hash = k_hash;
+
+    if (node.checkpoint == Node::k_none &&
+        node.ply % k_checkpoint_interval == 0) {
+        node.checkpoint = static_cast<std::uint32_t>(this->checkpoints.size());
+
+        this->checkpoints.push_back(fen());
+    }
+}
+
+void GameTree::retreat() {
+    Undo const undo = this->undos.back();
+
+    this->undos.pop_back();
+
+    this->nodes[this->path[this->current--]].move.decode().unmake(undo);
+}
+
+void GameTree::restore(std::size_t const ply) {
+    std::size_t start = ply;
+
+    while (this->nodes[this->path[start]].checkpoint == Node::k_none)
+        --start;
+
+    this->discard();
+
+    (void)load_fen(
+        this->checkpoints[this->nodes[this->path[start]].checkpoint]
+    );
+
+    for (std::size_t index = 0; index < start; ++index)
+        k_history.push_back(this->nodes[this->path[index]].hash);
+
+    this->current = start;
+
+    while (this->current < ply)
+        this->advance();
+}
+
+void GameTree::discard() {
+    for (Undo const &undo : this->undos) {
+        delete undo.captured;
+
+        if (undo.promoted)
+            delete undo.piece;
+    }
+
+    this->undos.clear();
+}
@@ -0,0 +1,72 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include "../board/zobrist.h"
+#include "../move/move.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class GameTree final {
+  public:
+    inline static std::size_t constexpr k_checkpoint_interval = 8;
+
+    struct Node final {
+        inline static std::uint32_t constexpr k_none = ~std::uint32_t{0};
+
+        PackedMove move;
+        std::uint16_t ply = 0;
+        std::uint32_t parent = k_none;
+        std::uint32_t child = k_none;
+        std::uint32_t sibling = k_none;
+        std::uint32_t main = k_none;
+        std::uint32_t checkpoint = k_none;
+        Hash hash = 0;
+    };
+
+    GameTree() = default;
+
+    GameTree(GameTree const &) = delete;
+
+    auto operator=(GameTree const &) -> GameTree & = delete;
+
+    ~GameTree();
+
+    [[nodiscard]] auto reset(std::string_view fen) -> bool;
+
+    void play(Move const &move);
+
+    auto undo() -> bool;
+
+    auto redo() -> bool;
+
+    void jump(std::size_t ply);
+
+    [[nodiscard]] auto ply() const -> std::size_t;
+
+    [[nodiscard]] auto root() const -> std::string const &;
+
+    [[nodiscard]] auto line() const -> std::vector<std::uint32_t> const &;
+
+    [[nodiscard]] auto node(std::uint32_t index) const -> Node const &;
+
+  private:
+    std::vector<Node> nodes;
+    std::vector<std::string> checkpoints;
+    std::vector<std::uint32_t> path;
+    std::vector<Undo> undos;
+    std::size_t current = 0;
+
+    void advance();
+
+    void retreat();
+
+    void restore(std::size_t ply);
+
+    void discard();
+};
+
+#endif // GAME_H
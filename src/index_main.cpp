@@ -0,0 +1,70 @@
+#include "archive/archive.h"
+#include "explorer/explorer.h"
+
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <thread>
+
+std::int32_t main(std::int32_t argc, char *argv[]) {
+    std::int32_t threads =
+        static_cast<std::int32_t>(std::thread::hardware_concurrency());
+    char const *archive_path = nullptr;
+    char const *index_path = nullptr;
+
+    for (std::int32_t i = 1; i < argc; ++i) {
+        std::string_view const argument = argv[i];
+
+        if (argument == "--threads" && i + 1 < argc) {
+            threads = std::stoi(argv[++i]);
+        } else if (argument.starts_with("--")) {
+            std::cerr << std::format("unknown option {}\n", argument);
+
+            return 1;
+        } else if (!archive_path) {
+            archive_path = argv[i];
+        } else {
+            index_path = argv[i];
+        }
+    }
+
+    if (!archive_path || !index_path) {
+        std::cerr << "usage: chess-index [--threads n] archive index\n";
+
+        return 1;
+    }
+
+    std::unique_ptr<ArchiveReader> const archive(
+        ArchiveReader::open(archive_path)
+    );
+
+    if (!archive) {
+        std::cerr << std::format("cannot open {}\n", archive_path);
+
+        return 1;
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+
+    std::optional<IndexSummary> const summary =
+        build_index(*archive, index_path, threads);
+
+    if (!summary) {
+        std::cerr << std::format("failed to build {}\n", index_path);
+
+        return 1;
+    }
+
+    auto const elapsed = std::chrono::steady_clock::now() - start;
+    double const seconds = std::chrono::duration<double>(elapsed).count();
+
+    std::cerr << std::format(
+        "{} games, {} positions, {} entries from {} runs in {:.2f} s\n",
+        summary->games, summary->positions, summary->entries, summary->runs,
+        seconds
+    );
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "server/loadgen.h"
+
+#include <charconv>
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+template <typename Number>
+static auto parse(std::string_view const text, Number &number) -> bool {
+    auto const [end, error] =
+        std::from_chars(text.data(), text.data() + text.size(), number);
+
+    return error == std::errc{} && end == text.data() + text.size();
+}
+
+std::int32_t main(std::int32_t argc, char *argv[]) {
+    LoadOptions options;
+
+    for (std::int32_t i = 1; i < argc; ++i) {
+        std::string_view const argument = argv[i];
+        bool parsed = i + 1 < argc;
+
+        if (argument == "--connect" && parsed) {
+            options.endpoint = argv[++i];
+        } else if (argument == "--clients" && parsed) {
+            parsed = parse(argv[++i], options.clients);
+        } else if (argument == "--sessions" && parsed) {
+            parsed = parse(argv[++i], options.sessions);
+        } else if (argument == "--requests" && parsed) {
+            parsed = parse(argv[++i], options.requests);
+        } else if (argument == "--engine-every" && parsed) {
+            parsed = parse(argv[++i], options.engine_every);
+        } else if (argument == "--nodes" && parsed) {
+            parsed = parse(argv[++i], options.nodes);
+        } else if (argument == "--seed" && parsed) {
+            parsed = parse(argv[++i], options.seed);
+        } else {
+            parsed = false;
+        }
+
+        if (!parsed) {
+            std::cerr << "usage: chess-loadgen [--connect path|[host:]port] "
+                         "[--clients n] [--sessions n] [--requests n] "
+                         "[--engine-every n] [--nodes n] [--seed n]\n";
+
+            return 1;
+        }
+    }
+
+    LoadSummary const summary = generate_load(options);
+
+    double const seconds =
+        std::chrono::duration<double>(summary.elapsed).count();
+    auto const microseconds = [](std::chrono::nanoseconds const duration)
+        -> double {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    };
+
+    std::cout << std::format(
+        "{} requests, {} games, {} errors in {:.2f} s: {:.0f} requests/s, "
+        "p50 {:.1f} us, p99 {:.1f} us, max {:.1f} us\n",
+        summary.requests, summary.games, summary.errors, seconds,
+        seconds > 0 ? static_cast<double>(summary.requests) / seconds : 0.0,
+        microseconds(summary.p50), microseconds(summary.p99),
+        microseconds(summary.max)
+    );
+
+    if (summary.failed) {
+        std::cerr << std::format(
+            "lost the connection to {}\n", options.endpoint
+        );
+
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,233 @@
+#include "engine.h"
+
+#include <array>
+#include <csignal>
+#include <format>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+using namespace std::chrono_literals;
+
+static std::chrono::milliseconds constexpr k_handshake_timeout = 10s;
+static std::chrono::milliseconds constexpr k_quit_timeout = 1s;
+static std::size_t constexpr k_read_size = 4096;
+
+Engine::~Engine() {
+    if (this->input >= 0) {
+        (void)this->send("quit");
+
+        close(this->input);
+    }
+
+    if (this->output >= 0)
+        close(this->output);
+
+    if (this->pid < 0)
+        return;
+
+    auto const deadline = std::chrono::steady_clock::now() + k_quit_timeout;
+
+    while (waitpid(this->pid, nullptr, WNOHANG) == 0) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            kill(this->pid, SIGKILL);
+            waitpid(this->pid, nullptr, 0);
+
+            break;
+        }
+
+        std::this_thread::sleep_for(10ms);
+    }
+}
+
+auto Engine::start(std::string const &command, Options const &options)
+    -> Engine * {
+    std::array<std::int32_t, 2> to{-1, -1};
+    std::array<std::int32_t, 2> from{-1, -1};
+
+    if (pipe2(to.data(), O_CLOEXEC) != 0)
+        return nullptr;
+
+    if (pipe2(from.data(), O_CLOEXEC) != 0) {
+        close(to[0]);
+        close(to[1]);
+
+        return nullptr;
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, to[0], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, from[1], STDOUT_FILENO);
+
+    std::array<char const *, 4> const arguments{
+        "/bin/sh", "-c", command.c_str(), nullptr
+    };
+
+    pid_t pid = -1;
+
+    std::int32_t const status = posix_spawn(
+        &pid, "/bin/sh", &actions, nullptr,
+        const_cast<char *const *>(arguments.data()), environ
+    );
+
+    posix_spawn_file_actions_destroy(&actions);
+
+    close(to[0]);
+    close(from[1]);
+
+    auto *engine = new Engine;
+
+    engine->input = to[1];
+    engine->output = from[0];
+
+    if (status != 0) {
+        delete engine;
+
+        return nullptr;
+    }
+
+    engine->pid = pid;
+
+    engine->identity = command;
+
+    if (!engine->send("uci") ||
+        !engine->wait_for("uciok", k_handshake_timeout)) {
+        delete engine;
+
+        return nullptr;
+    }
+
+    for (auto const &[name, value] : options)
+        if (!engine->send(
+                std::format("setoption name {} value {}", name, value)
+            )) {
+            delete engine;
+
+            return nullptr;
+        }
+
+    if (!engine->send("isready") ||
+        !engine->wait_for("readyok", k_handshake_timeout)) {
+        delete engine;
+
+        return nullptr;
+    }
+
+    return engine;
+}
+
+auto Engine::name() const -> std::string const & { return this->identity; }
+
+auto Engine::new_game() -> bool {
+    return this->send("ucinewgame") && this->send("isready") &&
+           this->wait_for("readyok", k_handshake_timeout);
+}
+
+auto Engine::best_move(
+    std::string_view const position, std::string_view const go,
+    std::chrono::milliseconds const timeout
+) -> std::optional<std::string> {
+    if (!this->send(position) || !this->send(go))
+        return std::nullopt;
+
+    std::optional<std::string> const line = this->wait_for("bestmove", timeout);
+
+    if (!line || line->size() <= 9)
+        return std::nullopt;
+
+    std::string const move = line->substr(9);
+
+    return move.substr(0, move.find(' '));
+}
+
+auto Engine::send(std::string_view const line) -> bool {
+    std::string const text = std::string(line) + '\n';
+
+    for (std::size_t written = 0; written < text.size();) {
+        ssize_t const count =
+            write(this->input, text.data() + written, text.size() - written);
+
+        if (count <= 0)
+            return false;
+
+        written += static_cast<std::size_t>(count);
+    }
+
+    return true;
+}
+
+auto Engine::read_line(std::chrono::milliseconds const timeout)
+    -> std::optional<std::string> {
+    auto const deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (true) {
+        if (std::size_t const end = this->buffer.find('\n');
+            end != std::string::npos) {
+            std::string line = this->buffer.substr(0, end);
+
+            this->buffer.erase(0, end + 1);
+
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+
+            return line;
+        }
+
+        auto const remaining =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()
+            );
+
+        if (remaining <= 0ms)
+            return std::nullopt;
+
+        pollfd descriptor{.fd = this->output, .events = POLLIN, .revents = 0};
+
+        if (poll(
+                &descriptor, 1, static_cast<std::int32_t>(remaining.count())
+            ) <= 0)
+            return std::nullopt;
+
+        std::array<char, k_read_size> chunk;
+
+        ssize_t const count = read(this->output, chunk.data(), chunk.size());
+
+        if (count <= 0)
+            return std::nullopt;
+
+        this->buffer.append(chunk.data(), static_cast<std::size_t>(count));
+    }
+}
+
+auto Engine::wait_for(
+    std::string_view const prefix, std::chrono::milliseconds const timeout
+) -> std::optional<std::string> {
+    auto const deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (true) {
+        std::optional<std::string> const line = this->read_line(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()
+            )
+        );
+
+        if (!line)
+            return std::nullopt;
+
+        std::string_view const text = *line;
+
+        if (text.starts_with("id name "))
+            this->identity = text.substr(8);
+
+        if (text.starts_with(prefix) &&
+            (text.size() == prefix.size() || text[prefix.size()] == ' '))
+            return line;
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <sys/types.h>
+
+class Engine final {
+  public:
+    using Options = std::vector<std::pair<std::string, std::string>>;
+
+    Engine(Engine const &) = delete;
+
+    auto operator=(Engine const &) -> Engine & = delete;
+
+    ~Engine();
+
+    [[nodiscard]] static auto
+    start(std::string const &command, Options const &options) -> Engine *;
+
+    [[nodiscard]] auto name() const -> std::string const &;
+
+    [[nodiscard]] auto new_game() -> bool;
+
+    [[nodiscard]] auto best_move(
+        std::string_view position, std::string_view go,
+        std::chrono::milliseconds timeout
+    ) -> std::optional<std::string>;
+
+  private:
+    pid_t pid = -1;
+    std::int32_t input = -1;
+    std::int32_t output = -1;
+    std::string buffer;
+    std::string identity;
+
+    Engine() = default;
+
+    auto send(std::string_view line) -> bool;
+
+    [[nodiscard]] auto read_line(std::chrono::milliseconds timeout)
+        -> std::optional<std::string>;
+
+    [[nodiscard]] auto wait_for(
+        std::string_view prefix, std::chrono::milliseconds timeout
+    ) -> std::optional<std::string>;
+};
+
+#endif // ENGINE_H
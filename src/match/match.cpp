@@ -0,0 +1,350 @@
+#include "match.h"
+
+#include "../archive/archive.h"
+#include "../board/board.h"
+#include "../vars.h"
+
+#include <algorithm>
+#include <format>
+#include <ranges>
+#include <string_view>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+static std::chrono::milliseconds constexpr k_timeout_margin = 1s;
+static std::chrono::milliseconds constexpr k_search_timeout = 60s;
+
+static auto opening_fen(std::string_view const line) -> std::string {
+    std::string fen;
+    std::size_t fields = 0;
+
+    for (auto const &field : line | std::views::split(' ')) {
+        if (field.empty())
+            continue;
+
+        if (fields++ == 4)
+            break;
+
+        if (!fen.empty())
+            fen += ' ';
+
+        fen += std::string_view(field.begin(), field.end());
+    }
+
+    return fen;
+}
+
+static auto go_command(
+    Limits const &limits,
+    std::array<std::chrono::milliseconds, 2> const &clocks
+) -> std::string {
+    std::string go = "go";
+
+    if (limits.movetime > 0ms)
+        go += std::format(" movetime {}", limits.movetime.count());
+
+    if (clocks[0] > 0ms || clocks[1] > 0ms)
+        go += std::format(
+            " wtime {} btime {} winc {} binc {}", clocks[0].count(),
+            clocks[1].count(), limits.increment[0].count(),
+            limits.increment[1].count()
+        );
+
+    if (limits.nodes)
+        go += std::format(" nodes {}", limits.nodes);
+
+    if (limits.depth < k_max_ply - 1)
+        go += std::format(" depth {}", limits.depth);
+
+    return go;
+}
+
+static auto draw_reason() -> std::string {
+    if (k_halfmove_clock >= 100)
+        return "fifty-move rule";
+
+    if (is_repetition(2))
+        return "threefold repetition";
+
+    return "insufficient material";
+}
+
+Match::Match(MatchOptions const &options) : options(options) {
+    this->options.concurrency = std::max(this->options.concurrency, 1);
+
+    if (this->options.openings.empty())
+        this->options.openings.emplace_back(k_start_fen);
+}
+
+Match::~Match() = default;
+
+auto Match::run(std::ostream &output) -> MatchSummary {
+    auto const start = std::chrono::steady_clock::now();
+
+    this->output = &output;
+    this->next = 0;
+    this->stopped = false;
+    this->summary = {};
+
+    std::erase_if(this->options.openings, [](std::string &opening) -> bool {
+        opening = opening_fen(opening);
+
+        return !load_fen(opening);
+    });
+
+    clear_board();
+
+    if (this->options.openings.empty()) {
+        this->summary.failed = true;
+
+        return this->summary;
+    }
+
+    if (this->options.archive) {
+        this->archive.reset(ArchiveWriter::open(this->options.archive));
+
+        if (!this->archive) {
+            this->summary.failed = true;
+
+            return this->summary;
+        }
+    }
+
+    std::vector<std::thread> workers;
+
+    for (std::uint64_t i = 0;
+         i < std::min<std::uint64_t>(
+                 this->options.games,
+                 static_cast<std::uint64_t>(this->options.concurrency)
+             );
+         ++i)
+        workers.emplace_back([this]() -> void { this->work(); });
+
+    for (std::thread &worker : workers)
+        worker.join();
+
+    if (this->archive && !this->archive->finish()) {
+        *this->output << std::format(
+            "failed to write the index of {}\n", this->options.archive
+        );
+
+        this->summary.failed = true;
+    }
+
+    this->archive.reset();
+
+    this->summary.elapsed = std::chrono::steady_clock::now() - start;
+
+    return this->summary;
+}
+
+void Match::work() {
+    std::array<std::unique_ptr<Engine>, 2> engines;
+
+    for (std::uint64_t index = this->next++;
+         index < this->options.games && !this->stopped;
+         index = this->next++) {
+        for (std::size_t i = 0; i < engines.size(); ++i)
+            if (!engines[i])
+                engines[i].reset(Engine::start(
+                    this->options.engines[i], this->options.options
+                ));
+
+        if (!engines[0] || !engines[1]) {
+            std::lock_guard const lock(this->mutex);
+
+            *this->output << "failed to start an engine\n";
+
+            this->summary.failed = true;
+            this->stopped = true;
+
+            break;
+        }
+
+        std::array<Engine *, 2> const players{
+            engines[0].get(), engines[1].get()
+        };
+
+        Game const game = this->play_game(index, players);
+
+        this->finish(index, game, players);
+
+        if (game.failed)
+            engines[*game.failed].reset();
+    }
+
+    clear_board();
+}
+
+auto Match::play_game(
+    std::uint64_t const index, std::array<Engine *, 2> const &engines
+) -> Game {
+    Limits const &limits = this->options.limits;
+    std::size_t const white = index % 2;
+
+    Game game{
+        .opening =
+            this->options.openings[index / 2 % this->options.openings.size()],
+    };
+
+    auto const lose = [&game](
+                          Colour const colour, std::string reason
+                      ) -> Game {
+        game.outcome =
+            colour == Colour::white ? Outcome::black : Outcome::white;
+        game.reason = std::move(reason);
+
+        return game;
+    };
+
+    for (std::size_t i = 0; i < engines.size(); ++i)
+        if (!engines[i]->new_game()) {
+            game.failed = i;
+
+            return lose(
+                i == white ? Colour::white : Colour::black, "engine not ready"
+            );
+        }
+
+    (void)load_fen(game.opening);
+
+    std::array<std::chrono::milliseconds, 2> clocks = limits.time;
+    std::string position = std::format("position fen {} moves", game.opening);
+
+    while (true) {
+        Colour const colour = k_current_player;
+        auto const side = static_cast<std::size_t>(colour);
+
+        if (!has_legal_moves()) {
+            if (in_check())
+                return lose(colour, "checkmate");
+
+            game.reason = "stalemate";
+
+            return game;
+        }
+
+        if (is_draw()) {
+            game.reason = draw_reason();
+
+            return game;
+        }
+
+        if (game.moves.size() >=
+            static_cast<std::size_t>(this->options.max_plies)) {
+            game.reason = "ply limit";
+
+            return game;
+        }
+
+        std::size_t const player = colour == Colour::white ? white : 1 - white;
+
+        std::chrono::milliseconds const timeout =
+            clocks[side] > 0ms      ? clocks[side] + k_timeout_margin
+            : limits.movetime > 0ms ? limits.movetime + k_timeout_margin
+                                    : k_search_timeout;
+
+        auto const start = std::chrono::steady_clock::now();
+
+        std::optional<std::string> const text = engines[player]->best_move(
+            position, go_command(limits, clocks), timeout
+        );
+
+        auto const elapsed =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start
+            );
+
+        if (!text) {
+            game.failed = player;
+
+            return lose(
+                colour, elapsed >= timeout ? "time forfeit" : "engine exited"
+            );
+        }
+
+        if (clocks[side] > 0ms) {
+            clocks[side] -= elapsed;
+
+            if (clocks[side] <= 0ms)
+                return lose(colour, "time forfeit");
+
+            clocks[side] += limits.increment[side];
+        }
+
+        std::optional<Move> const move = parse_uci(*text);
+
+        if (!move)
+            return lose(colour, std::format("illegal move {}", *text));
+
+        game.moves.push_back(PackedMove::encode(*move));
+
+        play(*move);
+
+        position += ' ' + *text;
+    }
+}
+
+void Match::finish(
+    std::uint64_t const index, Game const &game,
+    std::array<Engine *, 2> const &engines
+) {
+    std::size_t const white = index % 2;
+
+    std::lock_guard const lock(this->mutex);
+
+    Tally &tally = this->summary.tally;
+
+    if (game.outcome == Outcome::draw)
+        ++tally.draws;
+    else if ((game.outcome == Outcome::white) == (white == 0))
+        ++tally.wins;
+    else
+        ++tally.losses;
+
+    this->summary.estimate = estimate(tally);
+
+    std::string_view const result = game.outcome == Outcome::white ? "1-0"
+                                    : game.outcome == Outcome::black
+                                        ? "0-1"
+                                        : "1/2-1/2";
+
+    if (this->archive &&
+        !this->archive->append({
+            .tags =
+                {
+                    {"White", engines[white]->name()},
+                    {"Black", engines[1 - white]->name()},
+                    {"Result", std::string(result)},
+                    {"Termination", game.reason},
+                    {"FEN", game.opening},
+                },
+            .moves = game.moves,
+        }))
+        *this->output << std::format("failed to archive game {}\n", index + 1);
+
+    std::string line = std::format(
+        "game {} {} - {} {} ({}) | {}-{}-{} elo {:.1f} +/- {:.1f}",
+        index + 1, engines[white]->name(), engines[1 - white]->name(), result,
+        game.reason, tally.wins, tally.draws, tally.losses,
+        this->summary.estimate.elo, this->summary.estimate.margin
+    );
+
+    if (std::optional<Sprt> const &sprt = this->options.sprt) {
+        this->summary.llr = sprt->llr(tally);
+
+        line += std::format(
+            " llr {:.2f} ({:.2f}, {:.2f})", this->summary.llr, sprt->lower(),
+            sprt->upper()
+        );
+
+        if (!this->summary.accepted && (this->summary.llr >= sprt->upper() ||
+                                        this->summary.llr <= sprt->lower())) {
+            this->summary.accepted = this->summary.llr >= sprt->upper();
+            this->stopped = true;
+        }
+    }
+
+    *this->output << line << std::endl;
+}
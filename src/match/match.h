@@ -0,0 +1,83 @@
+#ifndef MATCH_H
+#define MATCH_H
+
+#include "../search/search.h"
+#include "engine.h"
+#include "sprt.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class ArchiveWriter;
+
+struct MatchOptions final {
+    std::array<std::string, 2> engines{};
+    Engine::Options options{};
+    std::vector<std::string> openings{};
+    std::uint64_t games = 2;
+    std::int32_t concurrency = 1;
+    Limits limits{};
+    std::int32_t max_plies = 400;
+    std::optional<Sprt> sprt{};
+    char const *archive = nullptr;
+};
+
+struct MatchSummary final {
+    Tally tally;
+    Estimate estimate;
+    double llr = 0;
+    std::optional<bool> accepted;
+    std::chrono::nanoseconds elapsed{};
+    bool failed = false;
+};
+
+class Match final {
+  public:
+    explicit Match(MatchOptions const &options);
+
+    ~Match();
+
+    [[nodiscard]] auto run(std::ostream &output) -> MatchSummary;
+
+  private:
+    enum class Outcome : std::uint8_t { white, draw, black };
+
+    struct Game final {
+        Outcome outcome = Outcome::draw;
+        std::string reason{};
+        std::string opening{};
+        std::vector<PackedMove> moves{};
+        std::optional<std::size_t> failed{};
+    };
+
+    MatchOptions options;
+
+    std::atomic<std::uint64_t> next = 0;
+    std::atomic<bool> stopped = false;
+
+    std::mutex mutex;
+    MatchSummary summary;
+    std::unique_ptr<ArchiveWriter> archive;
+    std::ostream *output = nullptr;
+
+    void work();
+
+    [[nodiscard]] auto play_game(
+        std::uint64_t index, std::array<Engine *, 2> const &engines
+    ) -> Game;
+
+    void finish(
+        std::uint64_t index, Game const &game,
+        std::array<Engine *, 2> const &engines
+    );
+};
+
+#endif // MATCH_H
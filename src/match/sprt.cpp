@@ -0,0 +1,76 @@
+#include "sprt.h"
+
+#include <algorithm>
+#include <cmath>
+
+static double constexpr k_z95 = 1.959963984540054;
+
+static auto variance(Tally const &tally) -> double {
+    double const games = static_cast<double>(tally.games());
+    double const score = tally.score();
+
+    return (static_cast<double>(tally.wins) * std::pow(1 - score, 2) +
+            static_cast<double>(tally.draws) * std::pow(0.5 - score, 2) +
+            static_cast<double>(tally.losses) * std::pow(score, 2)) /
+           games;
+}
+
+static auto to_elo(double const score) -> double {
+    double const clamped = std::clamp(score, 1e-6, 1 - 1e-6);
+
+    return -400 * std::log10(1 / clamped - 1);
+}
+
+static auto to_score(double const elo) -> double {
+    return 1 / (1 + std::pow(10, -elo / 400));
+}
+
+auto Tally::games() const -> std::uint64_t {
+    return this->wins + this->draws + this->losses;
+}
+
+auto Tally::score() const -> double {
+    if (!this->games())
+        return 0.5;
+
+    return (static_cast<double>(this->wins) +
+            static_cast<double>(this->draws) / 2) /
+           static_cast<double>(this->games());
+}
+
+auto estimate(Tally const &tally) -> Estimate {
+    if (!tally.games())
+        return {};
+
+    double const score = tally.score();
+    double const deviation =
+        std::sqrt(variance(tally) / static_cast<double>(tally.games()));
+
+    return {
+        .elo = to_elo(score),
+        .margin = (to_elo(score + k_z95 * deviation) -
+                   to_elo(score - k_z95 * deviation)) /
+                  2,
+    };
+}
+
+auto Sprt::llr(Tally const &tally) const -> double {
+    double const spread = variance(tally);
+
+    if (!tally.games() || spread <= 0)
+        return 0;
+
+    double const score0 = to_score(this->elo0);
+    double const score1 = to_score(this->elo1);
+
+    return static_cast<double>(tally.games()) * (score1 - score0) *
+           (2 * tally.score() - score0 - score1) / (2 * spread);
+}
+
+auto Sprt::lower() const -> double {
+    return std::log(this->beta / (1 - this->alpha));
+}
+
+auto Sprt::upper() const -> double {
+    return std::log((1 - this->beta) / this->alpha);
+}
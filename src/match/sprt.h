@@ -0,0 +1,36 @@
+#ifndef SPRT_H
+#define SPRT_H
+
+#include <cstdint>
+
+struct Tally final {
+    std::uint64_t wins = 0;
+    std::uint64_t draws = 0;
+    std::uint64_t losses = 0;
+
+    [[nodiscard]] auto games() const -> std::uint64_t;
+
+    [[nodiscard]] auto score() const -> double;
+};
+
+struct Estimate final {
+    double elo = 0;
+    double margin = 0;
+};
+
+[[nodiscard]] auto estimate(Tally const &tally) -> Estimate;
+
+struct Sprt final {
+    double elo0 = 0;
+    double elo1 = 5;
+    double alpha = 0.05;
+    double beta = 0.05;
+
+    [[nodiscard]] auto llr(Tally const &tally) const -> double;
+
+    [[nodiscard]] auto lower() const -> double;
+
+    [[nodiscard]] auto upper() const -> double;
+};
+
+#endif // SPRT_H
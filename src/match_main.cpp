@@ -0,0 +1,193 @@
+#include "match/match.h"
+
+#include <algorithm>
+#include <charconv>
+#include <csignal>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+static std::string_view constexpr k_default_time_control = "10+0.1";
+
+template <typename Number>
+static auto parse(std::string_view const text, Number &number) -> bool {
+    auto const [end, error] =
+        std::from_chars(text.data(), text.data() + text.size(), number);
+
+    return error == std::errc{} && end == text.data() + text.size();
+}
+
+static auto parse_time_control(std::string_view const text, Limits &limits)
+    -> bool {
+    std::size_t const plus = text.find('+');
+
+    double base = 0;
+    double increment = 0;
+
+    if (!parse(text.substr(0, plus), base) || base < 0 ||
+        (plus != std::string_view::npos &&
+         (!parse(text.substr(plus + 1), increment) || increment < 0)))
+        return false;
+
+    auto const milliseconds =
+        [](double const seconds) -> std::chrono::milliseconds {
+        return std::chrono::milliseconds(
+            static_cast<std::int64_t>(seconds * 1000)
+        );
+    };
+
+    limits.time = {milliseconds(base), milliseconds(base)};
+    limits.increment = {milliseconds(increment), milliseconds(increment)};
+
+    return true;
+}
+
+std::int32_t main(std::int32_t argc, char *argv[]) {
+    std::ios::sync_with_stdio(false);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    MatchOptions options{
+        .concurrency =
+            static_cast<std::int32_t>(std::thread::hardware_concurrency()),
+    };
+    std::size_t engines = 0;
+    char const *openings = nullptr;
+    Sprt sprt;
+    bool sequential = false;
+
+    for (std::int32_t i = 1; i < argc; ++i) {
+        std::string_view const argument = argv[i];
+
+        if (i + 1 >= argc) {
+            std::cerr << std::format("missing value for {}\n", argument);
+
+            return 1;
+        }
+
+        std::string_view const value = argv[++i];
+        std::int64_t milliseconds = 0;
+        bool parsed = true;
+
+        if (argument == "--engine" && engines < options.engines.size()) {
+            options.engines[engines++] = value;
+        } else if (argument == "--option") {
+            std::size_t const equals = value.find('=');
+
+            options.options.emplace_back(
+                value.substr(0, equals),
+                equals == std::string_view::npos ? ""
+                                                 : value.substr(equals + 1)
+            );
+        } else if (argument == "--openings") {
+            openings = argv[i];
+        } else if (argument == "--games") {
+            parsed = parse(value, options.games);
+        } else if (argument == "--concurrency") {
+            parsed = parse(value, options.concurrency);
+        } else if (argument == "--tc") {
+            parsed = parse_time_control(value, options.limits);
+        } else if (argument == "--movetime") {
+            parsed = parse(value, milliseconds) && milliseconds >= 0;
+            options.limits.movetime = std::chrono::milliseconds(milliseconds);
+        } else if (argument == "--depth") {
+            parsed = parse(value, options.limits.depth);
+            options.limits.depth =
+                std::clamp(options.limits.depth, 1, k_max_ply - 1);
+        } else if (argument == "--nodes") {
+            parsed = parse(value, options.limits.nodes);
+        } else if (argument == "--max-plies") {
+            parsed = parse(value, options.max_plies) && options.max_plies > 0;
+        } else if (argument == "--elo0") {
+            parsed = parse(value, sprt.elo0);
+            sequential = true;
+        } else if (argument == "--elo1") {
+            parsed = parse(value, sprt.elo1);
+            sequential = true;
+        } else if (argument == "--alpha") {
+            parsed = parse(value, sprt.alpha) && sprt.alpha > 0 &&
+                     sprt.alpha < 1;
+            sequential = true;
+        } else if (argument == "--beta") {
+            parsed =
+                parse(value, sprt.beta) && sprt.beta > 0 && sprt.beta < 1;
+            sequential = true;
+        } else if (argument == "--archive") {
+            options.archive = argv[i];
+        } else {
+            std::cerr << std::format("unknown option {}\n", argument);
+
+            return 1;
+        }
+
+        if (!parsed) {
+            std::cerr << std::format(
+                "invalid value {} for {}\n", value, argument
+            );
+
+            return 1;
+        }
+    }
+
+    if (engines != options.engines.size()) {
+        std::cerr << "usage: chess-match --engine command --engine command "
+                     "[--openings file.epd] [--games n] [--tc base+inc]\n";
+
+        return 1;
+    }
+
+    if (sequential)
+        options.sprt = sprt;
+
+    if (options.limits.movetime == std::chrono::milliseconds{} &&
+        options.limits.time[0] == std::chrono::milliseconds{} &&
+        !options.limits.nodes && options.limits.depth == k_max_ply - 1)
+        (void)parse_time_control(k_default_time_control, options.limits);
+
+    if (openings) {
+        std::ifstream file(openings);
+
+        if (!file) {
+            std::cerr << std::format("cannot open {}\n", openings);
+
+            return 1;
+        }
+
+        for (std::string line; std::getline(file, line);)
+            if (!line.empty() && line.front() != '#')
+                options.openings.push_back(line);
+    }
+
+    Match match(options);
+
+    MatchSummary const summary = match.run(std::cout);
+
+    if (summary.failed) {
+        std::cerr << "match failed\n";
+
+        return 1;
+    }
+
+    double const seconds =
+        std::chrono::duration<double>(summary.elapsed).count();
+
+    std::cerr << std::format(
+        "{} games in {:.1f} s: {}-{}-{}, elo {:.1f} +/- {:.1f}\n",
+        summary.tally.games(), seconds, summary.tally.wins,
+        summary.tally.draws, summary.tally.losses, summary.estimate.elo,
+        summary.estimate.margin
+    );
+
+    if (options.sprt)
+        std::cerr << std::format(
+            "sprt [{}, {}]: llr {:.2f}, {}\n", options.sprt->elo0,
+            options.sprt->elo1, summary.llr,
+            !summary.accepted ? "inconclusive"
+            : *summary.accepted ? "H1 accepted"
+                                : "H0 accepted"
+        );
+
+    return 0;
+}
@@ -1,28 +1,308 @@
 #include "move.h"
 
+#include "../board/board.h"
 #include "../pieces/pieces.h"
+#include "../stats/stats.h"
+#include "../stats/trace.h"
 #include "../vars.h"
 
+#include <cassert>
+#include <cstdlib>
+
+static auto key(Piece const &piece, Square const &square) -> Hash {
+    return k_zobrist.pieces[static_cast<std::size_t>(piece.colour)]
+                           [static_cast<std::size_t>(piece.type())]
+                           [square];
+}
+
+static void add_piece(Piece *piece, Square const &square) {
+    k_pieces[square] = piece;
+    k_evaluation.add(*piece, square);
+    k_accumulator.add(*piece, square);
+    k_hash ^= key(*piece, square);
+
+    if (typeid(*piece) == typeid(Pawn))
+        k_pawn_hash ^= key(*piece, square);
+}
+
+static auto remove_piece(Square const &square) -> Piece * {
+    Piece *piece = k_pieces[square];
+
+    k_hash ^= key(*piece, square);
+
+    if (typeid(*piece) == typeid(Pawn))
+        k_pawn_hash ^= key(*piece, square);
+
+    k_accumulator.remove(*piece, square);
+    k_evaluation.remove(*piece, square);
+    k_pieces[square] = nullptr;
+
+    return piece;
+}
+
 auto Move::is_valid() const -> bool {
+    return k_pieces[this->start]->colour == Colour::white
+               ? this->is_valid<Colour::white>()
+               : this->is_valid<Colour::black>();
+}
+
+template <Colour Us> auto Move::is_valid() const -> bool {
+    static std::size_t constexpr us = static_cast<std::size_t>(Us);
+
+    count(Counter::is_valid);
+
+    TraceSpan const span("is_valid");
+
     Piece *start_piece = k_pieces[this->start],
-          *end_piece = k_pieces[this->end];
+          *end_piece = k_pieces[this->end], *en_passant_piece = nullptr;
+
+    Square const &en_passant_square =
+        k_board[this->start.rank()][this->end.file()];
+
+    if (!end_piece && this->start.file() != this->end.file() &&
+        typeid(*start_piece) == typeid(Pawn)) {
+        en_passant_piece = k_pieces[en_passant_square];
+        k_pieces[en_passant_square] = nullptr;
+    }
 
     k_pieces[this->start] = nullptr;
     k_pieces[this->end] = start_piece;
 
-    Square const king_pos = k_king_pos[k_current_player];
+    Square const king_pos = k_king_pos[us];
 
     if (typeid(*start_piece) == typeid(King))
-        k_king_pos[k_current_player] = this->end;
+        k_king_pos[us] = this->end;
 
     bool const valid =
-        !dynamic_cast<King *>(k_pieces[k_king_pos[k_current_player]])
-             ->is_checked();
+        !static_cast<King *>(k_pieces[k_king_pos[us]])->is_checked<Us>();
 
     k_pieces[this->start] = start_piece;
     k_pieces[this->end] = end_piece;
 
-    k_king_pos[k_current_player] = king_pos;
+    if (en_passant_piece)
+        k_pieces[en_passant_square] = en_passant_piece;
+
+    k_king_pos[us] = king_pos;
 
     return valid;
-}
\ No newline at end of file
+}
+
+template auto Move::is_valid<Colour::white>() const -> bool;
+template auto Move::is_valid<Colour::black>() const -> bool;
+
+auto Move::make() const -> Undo {
+    return k_pieces[this->start]->colour == Colour::white
+               ? this->make<Colour::white>()
+               : this->make<Colour::black>();
+}
+
+template <Colour Us> auto Move::make() const -> Undo {
+    static std::size_t constexpr us = static_cast<std::size_t>(Us);
+    static Rank constexpr back_rank = k_back_rank<Us>;
+    static Rank constexpr en_passant_rank = back_rank + 3 * k_forward<Us>;
+
+    Undo undo{
+        .piece = k_pieces[this->start],
+        .captured_square = this->end,
+        .hash = k_hash,
+        .pawn_hash = k_pawn_hash,
+        .halfmove_clock = k_halfmove_clock,
+    };
+
+    TraceSpan const span("make");
+
+    std::uint32_t const rights = castling_rights();
+
+    k_history.push_back(k_hash);
+
+    if (std::int32_t const file = en_passant_file(); file >= 0)
+        k_hash ^= k_zobrist.en_passant[file];
+
+    {
+        TraceSpan const reset("make/en_passant");
+
+        for (Square const &square : k_board[en_passant_rank])
+            if (auto *pawn = dynamic_cast<Pawn *>(k_pieces[square]);
+                pawn && pawn->colour == Us && pawn->can_be_en_passanted) {
+                pawn->can_be_en_passanted = false;
+                undo.en_passant = pawn;
+            }
+    }
+
+    if (typeid(*undo.piece) == typeid(Pawn) &&
+        this->start.file() != this->end.file() && !k_pieces[this->end])
+        undo.captured_square = k_board[this->start.rank()][this->end.file()];
+
+    if (k_pieces[undo.captured_square])
+        undo.captured = remove_piece(undo.captured_square);
+
+    add_piece(remove_piece(this->start), this->end);
+
+    if (auto *pawn = dynamic_cast<Pawn *>(undo.piece)) {
+        undo.moved = pawn->moved;
+        pawn->moved = true;
+
+        if (std::int32_t const rank_diff =
+                this->end.rank() - this->start.rank();
+            rank_diff == -2 || rank_diff == 2) {
+            pawn->can_be_en_passanted = true;
+        } else if (this->end.rank() == k_back_rank<k_opponent<Us>>) {
+            undo.promoted = Piece::create(this->promotion, Us);
+
+            remove_piece(this->end);
+            add_piece(undo.promoted, this->end);
+        }
+    } else if (auto *king = dynamic_cast<King *>(undo.piece)) {
+        undo.moved = king->moved;
+        king->moved = true;
+
+        k_king_pos[us] = this->end;
+
+        for (std::size_t index = 0; File const file : std::array{0, 7}) {
+            if (auto *rook =
+                    dynamic_cast<Rook *>(k_pieces[k_board[back_rank][file]]);
+                rook && rook->colour == Us && rook->can_castle) {
+                rook->can_castle = false;
+                undo.rooks[index] = rook;
+            }
+
+            ++index;
+        }
+
+        if (std::int32_t const file_diff =
+                this->end.file() - this->start.file();
+            file_diff == -2 || file_diff == 2) {
+            Square const &rook_start =
+                k_board[back_rank][file_diff < 0 ? 0 : 7];
+            Square const &rook_end = k_board[back_rank][file_diff < 0 ? 3 : 5];
+
+            add_piece(remove_piece(rook_start), rook_end);
+
+            undo.castle = true;
+        }
+    } else if (auto *rook = dynamic_cast<Rook *>(undo.piece);
+               rook && rook->can_castle) {
+        rook->can_castle = false;
+        undo.rooks[0] = rook;
+    }
+
+    if (undo.captured || typeid(*undo.piece) == typeid(Pawn))
+        k_halfmove_clock = 0;
+    else
+        ++k_halfmove_clock;
+
+    if constexpr (Us == Colour::black)
+        ++k_fullmove_number;
+
+    k_current_player = k_opponent<Us>;
+
+    k_hash ^= k_zobrist.side ^ k_zobrist.castling[rights] ^
+              k_zobrist.castling[castling_rights()];
+
+    if (std::int32_t const file = en_passant_file(); file >= 0)
+        k_hash ^= k_zobrist.en_passant[file];
+
+    assert(k_evaluation == Evaluation::compute());
+    assert(k_hash == compute_hash());
+    assert(k_pawn_hash == compute_pawn_hash());
+
+    return undo;
+}
+
+template auto Move::make<Colour::white>() const -> Undo;
+template auto Move::make<Colour::black>() const -> Undo;
+
+void Move::unmake(Undo const &undo) const {
+    if (undo.piece->colour == Colour::white)
+        this->unmake<Colour::white>(undo);
+    else
+        this->unmake<Colour::black>(undo);
+}
+
+template <Colour Us> void Move::unmake(Undo const &undo) const {
+    static std::size_t constexpr us = static_cast<std::size_t>(Us);
+    static Rank constexpr back_rank = k_back_rank<Us>;
+
+    k_current_player = Us;
+
+    remove_piece(this->end);
+    add_piece(undo.piece, this->start);
+
+    delete undo.promoted;
+
+    if (undo.captured)
+        add_piece(undo.captured, undo.captured_square);
+
+    if (auto *pawn = dynamic_cast<Pawn *>(undo.piece)) {
+        pawn->moved = undo.moved;
+        pawn->can_be_en_passanted = false;
+    } else if (auto *king = dynamic_cast<King *>(undo.piece)) {
+        king->moved = undo.moved;
+
+        k_king_pos[us] = this->start;
+
+        if (undo.castle) {
+            bool const long_castle = this->end.file() < this->start.file();
+
+            Square const &rook_start = k_board[back_rank][long_castle ? 0 : 7];
+            Square const &rook_end = k_board[back_rank][long_castle ? 3 : 5];
+
+            add_piece(remove_piece(rook_end), rook_start);
+        }
+    }
+
+    for (Rook *rook : undo.rooks)
+        if (rook)
+            rook->can_castle = true;
+
+    if (undo.en_passant)
+        undo.en_passant->can_be_en_passanted = true;
+
+    if constexpr (Us == Colour::black)
+        --k_fullmove_number;
+
+    k_hash = undo.hash;
+    k_pawn_hash = undo.pawn_hash;
+    k_halfmove_clock = undo.halfmove_clock;
+    k_history.pop_back();
+
+    assert(k_evaluation == Evaluation::compute());
+    assert(k_hash == compute_hash());
+    assert(k_pawn_hash == compute_pawn_hash());
+}
+
+template void Move::unmake<Colour::white>(Undo const &undo) const;
+template void Move::unmake<Colour::black>(Undo const &undo) const;
+
+auto PackedMove::encode(Move const &move) -> PackedMove {
+    Piece const *piece = k_pieces[move.start];
+
+    std::uint8_t flags = k_pieces[move.end] ? capture : quiet;
+
+    if (piece->type() == PieceType::pawn) {
+        if (move.end.rank() == 0 || move.end.rank() == 7)
+            flags |= promotion |
+                     (static_cast<std::uint8_t>(move.promotion) - 1);
+        else if (move.start.file() != move.end.file() && !k_pieces[move.end])
+            flags = en_passant;
+        else if (std::abs(move.end.rank() - move.start.rank()) == 2)
+            flags = double_push;
+    } else if (piece->type() == PieceType::king &&
+               std::abs(move.end.file() - move.start.file()) == 2) {
+        flags =
+            move.end.file() > move.start.file() ? king_castle : queen_castle;
+    }
+
+    return {static_cast<std::uint16_t>(
+        move.start.index | move.end.index << 6 | flags << 12
+    )};
+}
+
+auto PackedMove::decode() const -> Move {
+    return {
+        .start = Square(this->from()),
+        .end = Square(this->to()),
+        .promotion =
+            this->is_promotion() ? this->promotion_type() : PieceType::queen,
+    };
+}
@@ -1,17 +1,111 @@
 #ifndef MOVE_H
 #define MOVE_H
 
+#include "../board/zobrist.h"
+#include "../colour.h"
+#include "../piece_type.h"
 #include "../square.h"
 
+#include <array>
+#include <cstdint>
+
+struct Piece;
+struct Pawn;
+struct Rook;
+
+struct Undo final {
+    Piece *piece = nullptr;
+    Piece *captured = nullptr;
+    Piece *promoted = nullptr;
+    Pawn *en_passant = nullptr;
+    std::array<Rook *, 2> rooks{};
+    Square captured_square{};
+    Hash hash = 0;
+    Hash pawn_hash = 0;
+    std::int32_t halfmove_clock = 0;
+    bool moved = false;
+    bool castle = false;
+};
+
 struct Move final {
     Square start;
     Square end;
+    PieceType promotion = PieceType::queen;
 
     [[nodiscard]] auto is_valid() const -> bool;
 
+    template <Colour Us> [[nodiscard]] auto is_valid() const -> bool;
+
+    [[nodiscard]] auto make() const -> Undo;
+
+    template <Colour Us> [[nodiscard]] auto make() const -> Undo;
+
+    void unmake(Undo const &undo) const;
+
+    template <Colour Us> void unmake(Undo const &undo) const;
+
     [[nodiscard]] bool operator==(Move const &) const = default;
 
     [[nodiscard]] auto operator<=>(Move const &) const = default;
 };
 
+struct PackedMove final {
+    enum Flag : std::uint8_t {
+        quiet = 0,
+        double_push = 1,
+        king_castle = 2,
+        queen_castle = 3,
+        capture = 4,
+        en_passant = 5,
+        promotion = 8,
+        promotion_capture = 12,
+    };
+
+    std::uint16_t data = 0;
+
+    [[nodiscard]] static auto encode(Move const &move) -> PackedMove;
+
+    [[nodiscard]] auto decode() const -> Move;
+
+    [[nodiscard]] constexpr auto from() const -> std::uint8_t {
+        return this->data & 63;
+    }
+
+    [[nodiscard]] constexpr auto to() const -> std::uint8_t {
+        return this->data >> 6 & 63;
+    }
+
+    [[nodiscard]] constexpr auto flags() const -> std::uint8_t {
+        return this->data >> 12;
+    }
+
+    [[nodiscard]] constexpr auto is_capture() const -> bool {
+        return this->flags() & capture;
+    }
+
+    [[nodiscard]] constexpr auto is_promotion() const -> bool {
+        return this->flags() & promotion;
+    }
+
+    [[nodiscard]] constexpr auto is_castle() const -> bool {
+        return this->flags() == king_castle || this->flags() == queen_castle;
+    }
+
+    [[nodiscard]] constexpr auto is_en_passant() const -> bool {
+        return this->flags() == en_passant;
+    }
+
+    [[nodiscard]] constexpr auto is_double_push() const -> bool {
+        return this->flags() == double_push;
+    }
+
+    [[nodiscard]] constexpr auto promotion_type() const -> PieceType {
+        return static_cast<PieceType>((this->flags() & 3) + 1);
+    }
+
+    [[nodiscard]] bool operator==(PackedMove const &) const = default;
+};
+
+static_assert(sizeof(PackedMove) == 2);
+
 #endif // MOVE_H
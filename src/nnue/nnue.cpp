@@ -0,0 +1,362 @@
+#include "nnue.h"
+
+#include "../eval/pawns.h"
+#include "../pieces/pieces.h"
+#include "../vars.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+static std::array<char, 4> constexpr k_magic{'N', 'N', 'U', 'E'};
+
+static std::size_t constexpr k_input_size = 2 * k_accumulator_size;
+
+static std::size_t constexpr k_feature_biases_offset = sizeof(k_magic);
+static std::size_t constexpr k_feature_weights_offset =
+    k_feature_biases_offset + k_accumulator_size * sizeof(std::int16_t);
+static std::size_t constexpr k_hidden1_biases_offset =
+    k_feature_weights_offset +
+    k_features * k_accumulator_size * sizeof(std::int16_t);
+static std::size_t constexpr k_hidden1_weights_offset =
+    k_hidden1_biases_offset + k_hidden_size * sizeof(std::int32_t);
+static std::size_t constexpr k_hidden2_biases_offset =
+    k_hidden1_weights_offset + k_hidden_size * k_input_size;
+static std::size_t constexpr k_hidden2_weights_offset =
+    k_hidden2_biases_offset + k_hidden_size * sizeof(std::int32_t);
+static std::size_t constexpr k_output_bias_offset =
+    k_hidden2_weights_offset + k_hidden_size * k_hidden_size;
+static std::size_t constexpr k_output_weights_offset =
+    k_output_bias_offset + sizeof(std::int32_t);
+static std::size_t constexpr k_network_size =
+    k_output_weights_offset + k_hidden_size;
+
+static_assert(k_hidden1_biases_offset % alignof(std::int32_t) == 0);
+static_assert(k_hidden2_biases_offset % alignof(std::int32_t) == 0);
+static_assert(k_output_bias_offset % alignof(std::int32_t) == 0);
+
+static std::int32_t constexpr k_weight_shift = 6;
+static std::int32_t constexpr k_output_scale = 16;
+
+Network::~Network() { munmap(this->mapping, this->size); }
+
+auto Network::load(char const *path) -> Network * {
+    std::int32_t const fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+        return nullptr;
+
+    struct stat status{};
+
+    if (fstat(fd, &status) != 0 ||
+        static_cast<std::size_t>(status.st_size) != k_network_size) {
+        close(fd);
+
+        return nullptr;
+    }
+
+    void *mapping =
+        mmap(nullptr, k_network_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+        return nullptr;
+
+    auto const *bytes = static_cast<char const *>(mapping);
+
+    if (std::memcmp(bytes, k_magic.data(), k_magic.size()) != 0) {
+        munmap(mapping, k_network_size);
+
+        return nullptr;
+    }
+
+    madvise(mapping, k_network_size, MADV_WILLNEED);
+
+    auto *network = new Network;
+
+    network->mapping = mapping;
+    network->size = k_network_size;
+
+    network->feature_biases = reinterpret_cast<std::int16_t const *>(
+        bytes + k_feature_biases_offset
+    );
+    network->feature_weights = reinterpret_cast<std::int16_t const *>(
+        bytes + k_feature_weights_offset
+    );
+    network->hidden1_biases = reinterpret_cast<std::int32_t const *>(
+        bytes + k_hidden1_biases_offset
+    );
+    network->hidden1_weights = reinterpret_cast<std::int8_t const *>(
+        bytes + k_hidden1_weights_offset
+    );
+    network->hidden2_biases = reinterpret_cast<std::int32_t const *>(
+        bytes + k_hidden2_biases_offset
+    );
+    network->hidden2_weights = reinterpret_cast<std::int8_t const *>(
+        bytes + k_hidden2_weights_offset
+    );
+    network->output_bias =
+        reinterpret_cast<std::int32_t const *>(bytes + k_output_bias_offset);
+    network->output_weights =
+        reinterpret_cast<std::int8_t const *>(bytes + k_output_weights_offset);
+
+    return network;
+}
+
+static auto feature(
+    Colour const perspective, Square const &king, Piece const &piece,
+    Square const &square
+) -> std::size_t {
+    std::size_t const flip = perspective == Colour::white ? 0 : 56;
+
+    std::size_t const king_index = king ^ flip;
+    std::size_t const square_index = square ^ flip;
+    std::size_t const piece_index =
+        static_cast<std::size_t>(piece.type()) * 2 +
+        (piece.colour == perspective ? 0 : 1);
+
+    return (king_index * 10 + piece_index) * 64 + square_index;
+}
+
+void Accumulator::add(Piece const &piece, Square const &square) {
+    if (!k_network || piece.type() == PieceType::king)
+        return;
+
+    for (Colour const perspective : {Colour::white, Colour::black}) {
+        auto const colour = static_cast<std::size_t>(perspective);
+
+        if (this->kings[colour] == k_no_square)
+            continue;
+
+        std::int16_t const *weights =
+            k_network->feature_weights +
+            feature(perspective, this->kings[colour], piece, square) *
+                k_accumulator_size;
+
+        for (std::size_t index = 0; index < k_accumulator_size; ++index)
+            this->values[colour][index] += weights[index];
+    }
+}
+
+void Accumulator::remove(Piece const &piece, Square const &square) {
+    if (!k_network || piece.type() == PieceType::king)
+        return;
+
+    for (Colour const perspective : {Colour::white, Colour::black}) {
+        auto const colour = static_cast<std::size_t>(perspective);
+
+        if (this->kings[colour] == k_no_square)
+            continue;
+
+        std::int16_t const *weights =
+            k_network->feature_weights +
+            feature(perspective, this->kings[colour], piece, square) *
+                k_accumulator_size;
+
+        for (std::size_t index = 0; index < k_accumulator_size; ++index)
+            this->values[colour][index] -= weights[index];
+    }
+}
+
+void Accumulator::refresh(Colour const perspective) {
+    auto const colour = static_cast<std::size_t>(perspective);
+
+    Square const &king = k_king_pos[colour];
+
+    std::copy_n(
+        k_network->feature_biases, k_accumulator_size,
+        this->values[colour].begin()
+    );
+
+    for (Square const &square : k_squares) {
+        Piece const *piece = k_pieces[square];
+
+        if (!piece || piece->type() == PieceType::king)
+            continue;
+
+        std::int16_t const *weights =
+            k_network->feature_weights +
+            feature(perspective, king, *piece, square) * k_accumulator_size;
+
+        for (std::size_t index = 0; index < k_accumulator_size; ++index)
+            this->values[colour][index] += weights[index];
+    }
+
+    this->kings[colour] = king;
+}
+
+using Affine = void (*)(
+    std::uint8_t const *, std::int8_t const *, std::int32_t const *,
+    std::int32_t *, std::size_t, std::size_t
+);
+
+static void affine_scalar(
+    std::uint8_t const *input, std::int8_t const *weights,
+    std::int32_t const *biases, std::int32_t *output, std::size_t const inputs,
+    std::size_t const outputs
+) {
+    for (std::size_t row = 0; row < outputs; ++row) {
+        std::int8_t const *row_weights = weights + row * inputs;
+
+        std::int32_t sum = biases[row];
+
+        for (std::size_t index = 0; index < inputs; ++index)
+            sum += static_cast<std::int32_t>(input[index]) * row_weights[index];
+
+        output[row] = sum;
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+[[gnu::target("avx2")]] static void affine_avx2(
+    std::uint8_t const *input, std::int8_t const *weights,
+    std::int32_t const *biases, std::int32_t *output, std::size_t const inputs,
+    std::size_t const outputs
+) {
+    __m256i const ones = _mm256_set1_epi16(1);
+
+    for (std::size_t row = 0; row < outputs; ++row) {
+        std::int8_t const *row_weights = weights + row * inputs;
+
+        __m256i sum = _mm256_setzero_si256();
+
+        for (std::size_t index = 0; index < inputs; index += 32) {
+            __m256i const product = _mm256_maddubs_epi16(
+                _mm256_loadu_si256(
+                    reinterpret_cast<__m256i const *>(input + index)
+                ),
+                _mm256_loadu_si256(
+                    reinterpret_cast<__m256i const *>(row_weights + index)
+                )
+            );
+
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(product, ones));
+        }
+
+        __m128i total = _mm_add_epi32(
+            _mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1)
+        );
+        total = _mm_hadd_epi32(total, total);
+        total = _mm_hadd_epi32(total, total);
+
+        output[row] = biases[row] + _mm_cvtsi128_si32(total);
+    }
+}
+
+[[gnu::target("sse4.1")]] static void affine_sse41(
+    std::uint8_t const *input, std::int8_t const *weights,
+    std::int32_t const *biases, std::int32_t *output, std::size_t const inputs,
+    std::size_t const outputs
+) {
+    __m128i const ones = _mm_set1_epi16(1);
+
+    for (std::size_t row = 0; row < outputs; ++row) {
+        std::int8_t const *row_weights = weights + row * inputs;
+
+        __m128i sum = _mm_setzero_si128();
+
+        for (std::size_t index = 0; index < inputs; index += 16) {
+            __m128i const product = _mm_maddubs_epi16(
+                _mm_loadu_si128(
+                    reinterpret_cast<__m128i const *>(input + index)
+                ),
+                _mm_loadu_si128(
+                    reinterpret_cast<__m128i const *>(row_weights + index)
+                )
+            );
+
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(product, ones));
+        }
+
+        sum = _mm_hadd_epi32(sum, sum);
+        sum = _mm_hadd_epi32(sum, sum);
+
+        output[row] = biases[row] + _mm_cvtsi128_si32(sum);
+    }
+}
+#endif
+
+static auto select_affine() -> Affine {
+#if defined(__x86_64__) || defined(__i386__)
+    if (__builtin_cpu_supports("avx2"))
+        return affine_avx2;
+
+    if (__builtin_cpu_supports("sse4.1"))
+        return affine_sse41;
+#endif
+
+    return affine_scalar;
+}
+
+static Affine const k_affine = select_affine();
+
+static void clipped_relu(
+    std::int32_t const *input, std::uint8_t *output, std::size_t const size
+) {
+    for (std::size_t index = 0; index < size; ++index)
+        output[index] = static_cast<std::uint8_t>(
+            std::clamp(input[index] >> k_weight_shift, 0, 127)
+        );
+}
+
+auto Accumulator::evaluate(Colour const colour) -> Score {
+    for (Colour const perspective : {Colour::white, Colour::black})
+        if (auto const side = static_cast<std::size_t>(perspective);
+            this->kings[side] != k_king_pos[side])
+            this->refresh(perspective);
+
+    alignas(64) std::array<std::uint8_t, k_input_size> input;
+    alignas(64) std::array<std::int32_t, k_hidden_size> hidden;
+    alignas(64) std::array<std::uint8_t, k_hidden_size> hidden1;
+    alignas(64) std::array<std::uint8_t, k_hidden_size> hidden2;
+
+    auto const us = static_cast<std::size_t>(colour);
+
+    for (std::size_t index = 0; index < k_accumulator_size; ++index) {
+        input[index] = static_cast<std::uint8_t>(std::clamp<std::int16_t>(
+            this->values[us][index], 0, 127
+        ));
+        input[k_accumulator_size + index] =
+            static_cast<std::uint8_t>(std::clamp<std::int16_t>(
+                this->values[us ^ 1][index], 0, 127
+            ));
+    }
+
+    k_affine(
+        input.data(), k_network->hidden1_weights, k_network->hidden1_biases,
+        hidden.data(), k_input_size, k_hidden_size
+    );
+    clipped_relu(hidden.data(), hidden1.data(), k_hidden_size);
+
+    k_affine(
+        hidden1.data(), k_network->hidden2_weights, k_network->hidden2_biases,
+        hidden.data(), k_hidden_size, k_hidden_size
+    );
+    clipped_relu(hidden.data(), hidden2.data(), k_hidden_size);
+
+    std::int32_t output;
+
+    k_affine(
+        hidden2.data(), k_network->output_weights, k_network->output_bias,
+        &output, k_hidden_size, 1
+    );
+
+    return output / k_output_scale;
+}
+
+auto evaluate() -> Score {
+    if (k_network)
+        return k_accumulator.evaluate(k_current_player);
+
+    return k_evaluation.score(k_current_player) +
+           pawn_structure(k_current_player);
+}
@@ -0,0 +1,61 @@
+#ifndef NNUE_H
+#define NNUE_H
+
+#include "../colour.h"
+#include "../eval/tables.h"
+#include "../square.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+struct Piece;
+
+inline static std::size_t constexpr k_features = 64 * 10 * 64;
+inline static std::size_t constexpr k_accumulator_size = 256;
+inline static std::size_t constexpr k_hidden_size = 32;
+
+struct Network final {
+    std::int16_t const *feature_biases = nullptr;
+    std::int16_t const *feature_weights = nullptr;
+    std::int32_t const *hidden1_biases = nullptr;
+    std::int8_t const *hidden1_weights = nullptr;
+    std::int32_t const *hidden2_biases = nullptr;
+    std::int8_t const *hidden2_weights = nullptr;
+    std::int32_t const *output_bias = nullptr;
+    std::int8_t const *output_weights = nullptr;
+
+    Network(Network const &) = delete;
+
+    auto operator=(Network const &) -> Network & = delete;
+
+    ~Network();
+
+    [[nodiscard]] static auto load(char const *path) -> Network *;
+
+  private:
+    void *mapping = nullptr;
+    std::size_t size = 0;
+
+    Network() = default;
+};
+
+struct Accumulator final {
+    alignas(64) std::array<std::array<std::int16_t, k_accumulator_size>, 2>
+        values{};
+    std::array<Square, 2> kings{k_no_square, k_no_square};
+
+    void add(Piece const &piece, Square const &square);
+
+    void remove(Piece const &piece, Square const &square);
+
+    void refresh(Colour perspective);
+
+    [[nodiscard]] auto evaluate(Colour colour) -> Score;
+};
+
+inline Network *k_network = nullptr;
+
+[[nodiscard]] auto evaluate() -> Score;
+
+#endif // NNUE_H
@@ -0,0 +1,72 @@
+#include "board/board.h"
+#include "move/move.h"
+
+#include <array>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+struct PerftCase final {
+    std::string_view fen;
+    std::int32_t depth;
+    std::uint64_t nodes;
+};
+
+static std::array<PerftCase, 6> constexpr k_cases{{
+    {k_start_fen, 4, 197281},
+    {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3,
+     97862},
+    {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 4, 43238},
+    {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 3,
+     9467},
+    {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3, 62379},
+    {"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+     3, 89890},
+}};
+
+static auto perft(std::int32_t const depth) -> std::uint64_t {
+    std::vector<Move> const moves = legal_moves();
+
+    if (depth <= 1)
+        return depth == 1 ? moves.size() : 1;
+
+    std::uint64_t nodes = 0;
+
+    for (Move const &move : moves) {
+        Undo const undo = move.make();
+
+        nodes += perft(depth - 1);
+
+        move.unmake(undo);
+    }
+
+    return nodes;
+}
+
+std::int32_t main() {
+    std::int32_t failures = 0;
+
+    for (PerftCase const &test : k_cases) {
+        if (!load_fen(test.fen)) {
+            std::cerr << std::format("invalid fen {}\n", test.fen);
+
+            return 1;
+        }
+
+        std::uint64_t const nodes = perft(test.depth);
+
+        std::cout << std::format(
+            "{} depth {}: {} nodes{}\n", test.fen, test.depth, nodes,
+            nodes == test.nodes ? ""
+                                : std::format(", expected {}", test.nodes)
+        );
+
+        failures += nodes != test.nodes;
+    }
+
+    clear_board();
+
+    return failures ? 1 : 0;
+}
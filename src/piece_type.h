@@ -0,0 +1,6 @@
+#ifndef PIECE_TYPE_H
+#define PIECE_TYPE_H
+
+enum class PieceType { pawn, knight, bishop, rook, queen, king };
+
+#endif // PIECE_TYPE_H
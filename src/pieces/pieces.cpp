@@ -1,141 +1,104 @@
 #include "pieces.h"
 
 #include "../move/move.h"
+#include "../stats/stats.h"
+#include "../stats/trace.h"
 #include "../vars.h"
 
+#include <algorithm>
 #include <ranges>
 
 Piece::Piece(Colour const colour) : colour(colour) {}
 
+auto Piece::create(PieceType const type, Colour const colour) -> Piece * {
+    switch (type) {
+    case PieceType::pawn:
+        return new Pawn(colour);
+    case PieceType::knight:
+        return new Knight(colour);
+    case PieceType::bishop:
+        return new Bishop(colour);
+    case PieceType::rook:
+        return new Rook(colour);
+    case PieceType::queen:
+        return new Queen(colour);
+    case PieceType::king:
+        return new King(colour);
+    }
+
+    return nullptr;
+}
+
+auto Pawn::type() const -> PieceType { return PieceType::pawn; }
+
 auto Pawn::get_moves(Square const &current_square) -> std::set<Move> {
-    std::set<Move> moves;
+    return this->colour == Colour::white
+               ? this->get_moves<Colour::white>(current_square)
+               : this->get_moves<Colour::black>(current_square);
+}
 
-    auto const &[rank, file] = current_square;
-    std::array<Square, 8> const &current_rank = k_board[rank];
+template <Colour Us>
+auto Pawn::get_moves(Square const &current_square) -> std::set<Move> {
+    static Rank constexpr start_rank = k_back_rank<Us> + k_forward<Us>;
 
-    std::array<Square, 8> const *front_rank;
+    count(Counter::get_moves);
 
-    if (this->colour == Colour::white) {
-        front_rank = &k_board[rank - 1];
+    TraceSpan const span("get_moves");
 
-        if (rank > 1)
-            if (std::array<Square, 8> const &two_front_rank = k_board[rank - 2];
-                !this->moved && !k_pieces[two_front_rank[file]])
-                moves.emplace(current_square, two_front_rank[file]);
-    } else {
-        front_rank = &k_board[rank + 1];
+    std::set<Move> moves;
 
-        if (rank < 6)
-            if (std::array<Square, 8> const &two_front_rank = k_board[rank + 2];
-                !this->moved && !k_pieces[two_front_rank[file]])
-                moves.emplace(current_square, two_front_rank[file]);
-    }
+    Rank const rank = current_square.rank();
+    File const file = current_square.file();
+    std::array<Square, 8> const &current_rank = k_board[rank];
 
-    if (!k_pieces[front_rank->at(file)])
-        moves.emplace(current_square, front_rank->at(file));
+    if (Rank const ahead = rank + k_forward<Us>; ahead >= 0 && ahead < 8) {
+        if (Square const &front = k_board[ahead][file]; !k_pieces[front]) {
+            moves.emplace(current_square, front);
 
-    if (file != 0) {
-        Piece const *piece = k_pieces[front_rank->at(file - 1)];
-        auto const *pawn =
-            dynamic_cast<Pawn *>(k_pieces[current_rank[file - 1]]);
+            if (rank == start_rank) {
+                Square const &two_front = k_board[ahead + k_forward<Us>][file];
 
-        if ((piece && piece->colour != this->colour) ||
-            (pawn && pawn->can_be_en_passanted && pawn->colour != this->colour))
-            moves.emplace(current_square, front_rank->at(file - 1));
+                if (!k_pieces[two_front])
+                    moves.emplace(current_square, two_front);
+            }
+        }
     }
 
-    if (file != 7) {
-        Piece const *piece = k_pieces[front_rank->at(file + 1)];
+    for (Square const &square :
+         k_pawn_attacks[static_cast<std::size_t>(Us)][current_square]) {
+        Piece const *piece = k_pieces[square];
         auto const *pawn =
-            dynamic_cast<Pawn *>(k_pieces[current_rank[file + 1]]);
+            dynamic_cast<Pawn *>(k_pieces[current_rank[square.file()]]);
 
-        if ((piece && piece->colour != this->colour) ||
-            (pawn && pawn->can_be_en_passanted && pawn->colour != this->colour))
-            moves.emplace(current_square, front_rank->at(file + 1));
+        if ((piece && piece->colour != Us) ||
+            (pawn && pawn->can_be_en_passanted && pawn->colour != Us))
+            moves.emplace(current_square, square);
     }
 
     return moves | std::views::filter([](Move const &move) -> bool {
-               return move.is_valid();
+               return move.is_valid<Us>();
            }) |
            std::ranges::to<std::set>();
 }
 
-auto Knight::get_moves(Square const &current_square) -> std::set<Move> {
-    std::set<Move> moves;
-
-    auto const &[rank, file] = current_square;
-
-    if (rank >= 1) {
-        if (file >= 2) {
-            Square const &square = k_board[rank - 1][file - 2];
-
-            if (Piece const *piece = k_pieces[square];
-                !piece || piece->colour != this->colour)
-                moves.emplace(current_square, square);
-        }
-
-        if (file < 6) {
-            Square const &square = k_board[rank - 1][file + 2];
-
-            if (Piece const *piece = k_pieces[square];
-                !piece || piece->colour != this->colour)
-                moves.emplace(current_square, square);
-        }
+template auto Pawn::get_moves<Colour::white>(Square const &current_square)
+    -> std::set<Move>;
+template auto Pawn::get_moves<Colour::black>(Square const &current_square)
+    -> std::set<Move>;
 
-        if (rank >= 2) {
-            if (file >= 1) {
-                Square const &square = k_board[rank - 2][file - 1];
-
-                if (Piece const *piece = k_pieces[square];
-                    !piece || piece->colour != this->colour)
-                    moves.emplace(current_square, square);
-            }
-
-            if (file < 7) {
-                Square const &square = k_board[rank - 2][file + 1];
-
-                if (Piece const *piece = k_pieces[square];
-                    !piece || piece->colour != this->colour)
-                    moves.emplace(current_square, square);
-            }
-        }
-    }
+auto Knight::type() const -> PieceType { return PieceType::knight; }
 
-    if (rank < 7) {
-        if (file >= 2) {
-            Square const &square = k_board[rank + 1][file - 2];
-
-            if (Piece const *piece = k_pieces[square];
-                !piece || piece->colour != this->colour)
-                moves.emplace(current_square, square);
-        }
-
-        if (file < 6) {
-            Square const &square = k_board[rank + 1][file + 2];
-
-            if (Piece const *piece = k_pieces[square];
-                !piece || piece->colour != this->colour)
-                moves.emplace(current_square, square);
-        }
-
-        if (rank < 6) {
-            if (file >= 1) {
-                Square const &square = k_board[rank + 2][file - 1];
+auto Knight::get_moves(Square const &current_square) -> std::set<Move> {
+    count(Counter::get_moves);
 
-                if (Piece const *piece = k_pieces[square];
-                    !piece || piece->colour != this->colour)
-                    moves.emplace(current_square, square);
-            }
+    TraceSpan const span("get_moves");
 
-            if (file < 7) {
-                Square const &square = k_board[rank + 2][file + 1];
+    std::set<Move> moves;
 
-                if (Piece const *piece = k_pieces[square];
-                    !piece || piece->colour != this->colour)
-                    moves.emplace(current_square, square);
-            }
-        }
-    }
+    for (Square const &square : k_knight_attacks[current_square])
+        if (Piece const *piece = k_pieces[square];
+            !piece || piece->colour != this->colour)
+            moves.emplace(current_square, square);
 
     return moves | std::views::filter([](Move const &move) -> bool {
                return move.is_valid();
@@ -143,10 +106,17 @@ auto Knight::get_moves(Square const &current_square) -> std::set<Move> {
            std::ranges::to<std::set>();
 }
 
+auto Bishop::type() const -> PieceType { return PieceType::bishop; }
+
 auto Bishop::get_moves(Square const &current_square) -> std::set<Move> {
+    count(Counter::get_moves);
+
+    TraceSpan const span("get_moves");
+
     std::set<Move> moves;
 
-    auto const &[rank, file] = current_square;
+    Rank const rank = current_square.rank();
+    File const file = current_square.file();
 
     File left_file = file - 1, right_file = file + 1;
 
@@ -228,10 +198,17 @@ auto Bishop::get_moves(Square const &current_square) -> std::set<Move> {
            std::ranges::to<std::set>();
 }
 
+auto Rook::type() const -> PieceType { return PieceType::rook; }
+
 auto Rook::get_moves(Square const &current_square) -> std::set<Move> {
+    count(Counter::get_moves);
+
+    TraceSpan const span("get_moves");
+
     std::set<Move> moves;
 
-    auto const &[rank, file] = current_square;
+    Rank const rank = current_square.rank();
+    File const file = current_square.file();
 
     for (std::array<Square, 8> const &array :
          k_board | std::views::take(rank) | std::views::reverse) {
@@ -290,7 +267,13 @@ auto Rook::get_moves(Square const &current_square) -> std::set<Move> {
            std::ranges::to<std::set>();
 }
 
+auto Queen::type() const -> PieceType { return PieceType::queen; }
+
 auto Queen::get_moves(Square const &current_square) -> std::set<Move> {
+    count(Counter::get_moves);
+
+    TraceSpan const span("get_moves");
+
     std::set<Move> const &rank_and_files =
         Rook(this->colour).get_moves(current_square);
     std::set<Move> const &diagonals =
@@ -303,135 +286,92 @@ auto Queen::get_moves(Square const &current_square) -> std::set<Move> {
     return moves;
 }
 
+auto King::type() const -> PieceType { return PieceType::king; }
+
 auto King::get_moves(Square const &current_square) -> std::set<Move> {
-    std::set<Move> moves;
-    auto const &[opposite_king_rank, opposite_king_file] = k_king_pos[(
-        this->colour == Colour::white ? Colour::black : Colour::white
-    )];
-
-    for (auto const &[x, y] : std::views::cartesian_product(
-             std::array{-1, 0, 1}, std::array{-1, 0, 1}
-         )) {
-        if (!x && !y)
-            continue;
+    return this->colour == Colour::white
+               ? this->get_moves<Colour::white>(current_square)
+               : this->get_moves<Colour::black>(current_square);
+}
+
+template <Colour Us>
+auto King::get_moves(Square const &current_square) -> std::set<Move> {
+    static Rank constexpr rank = k_back_rank<Us>;
 
-        Rank const rank = current_square.rank + x;
-        File const file = current_square.file + y;
+    count(Counter::get_moves);
 
-        if (0 > rank || rank >= 8 || 0 > file || file >= 8)
-            continue;
+    TraceSpan const span("get_moves");
 
-        if (std::int32_t const rank_diff = opposite_king_rank - rank,
-            file_diff = opposite_king_file - file;
-            rank_diff > -2 && rank_diff < 2 && file_diff > -2 && file_diff < 2)
-            continue;
+    std::set<Move> moves;
+
+    Attacks const &opposite_king_attacks =
+        k_king_attacks[k_king_pos[static_cast<std::size_t>(k_opponent<Us>)]];
 
-        Square const &square = k_board[rank][file];
+    for (Square const &square : k_king_attacks[current_square]) {
+        if (std::ranges::find(opposite_king_attacks, square) !=
+            opposite_king_attacks.end())
+            continue;
 
         if (Piece const *piece = k_pieces[square];
-            piece && piece->colour == this->colour)
+            piece && piece->colour == Us)
             continue;
 
         moves.emplace(current_square, square);
     }
 
-    if (!this->moved && !this->is_checked()) {
-        Rank const rank = this->colour == Colour::white ? 7 : 0;
-
+    if (!this->moved && !this->is_checked<Us>()) {
         if (auto const *long_rook =
                 dynamic_cast<Rook *>(k_pieces[k_board[rank][0]]);
             long_rook && long_rook->can_castle && !k_pieces[k_board[rank][1]] &&
             !k_pieces[k_board[rank][2]] && !k_pieces[k_board[rank][3]] &&
-            Move(current_square, k_board[rank][3]).is_valid())
+            Move(current_square, k_board[rank][3]).is_valid<Us>())
             moves.emplace(current_square, k_board[rank][2]);
 
         if (auto const *short_rook =
                 dynamic_cast<Rook *>(k_pieces[k_board[rank][7]]);
             short_rook && short_rook->can_castle &&
             !k_pieces[k_board[rank][5]] && !k_pieces[k_board[rank][6]] &&
-            Move(current_square, k_board[rank][5]).is_valid())
+            Move(current_square, k_board[rank][5]).is_valid<Us>())
             moves.emplace(current_square, k_board[rank][6]);
     }
 
     return moves | std::views::filter([](Move const &move) -> bool {
-               return move.is_valid();
+               return move.is_valid<Us>();
            }) |
            std::ranges::to<std::set>();
 }
 
+template auto King::get_moves<Colour::white>(Square const &current_square)
+    -> std::set<Move>;
+template auto King::get_moves<Colour::black>(Square const &current_square)
+    -> std::set<Move>;
+
 auto King::is_checked() const -> bool {
-    auto const &[rank, file] = k_king_pos[this->colour];
+    return this->colour == Colour::white ? this->is_checked<Colour::white>()
+                                         : this->is_checked<Colour::black>();
+}
 
-    std::array<Square, 8> const &front_rank =
-        this->colour == Colour::white ? k_board[rank - 1] : k_board[rank + 1];
+template <Colour Us> auto King::is_checked() const -> bool {
+    count(Counter::is_checked);
 
-    if (file != 0)
-        if (Piece const *piece = k_pieces[front_rank[file - 1]];
-            piece && typeid(*piece) == typeid(Pawn) &&
-            piece->colour != this->colour)
-            return true;
+    TraceSpan const span("is_checked");
 
-    if (file != 7)
-        if (Piece const *piece = k_pieces[front_rank[file + 1]];
+    Square const &king = k_king_pos[static_cast<std::size_t>(Us)];
+    Rank const rank = king.rank();
+    File const file = king.file();
+
+    for (Square const &square :
+         k_pawn_attacks[static_cast<std::size_t>(Us)][king])
+        if (Piece const *piece = k_pieces[square];
             piece && typeid(*piece) == typeid(Pawn) &&
-            piece->colour != this->colour)
+            piece->colour != Us)
             return true;
 
-    if (rank >= 1) {
-        if (file >= 2)
-            if (Piece const *piece = k_pieces[k_board[rank - 1][file - 2]];
-                piece && typeid(*piece) == typeid(Knight) &&
-                piece->colour != this->colour)
-                return true;
-
-        if (file < 6)
-            if (Piece const *piece = k_pieces[k_board[rank - 1][file + 2]];
-                piece && typeid(*piece) == typeid(Knight) &&
-                piece->colour != this->colour)
-                return true;
-
-        if (rank >= 2) {
-            if (file >= 1)
-                if (Piece const *piece = k_pieces[k_board[rank - 2][file - 1]];
-                    piece && typeid(*piece) == typeid(Knight) &&
-                    piece->colour != this->colour)
-                    return true;
-
-            if (file < 7)
-                if (Piece const *piece = k_pieces[k_board[rank - 2][file + 1]];
-                    piece && typeid(*piece) == typeid(Knight) &&
-                    piece->colour != this->colour)
-                    return true;
-        }
-    }
-
-    if (rank < 7) {
-        if (file >= 2)
-            if (Piece const *piece = k_pieces[k_board[rank + 1][file - 2]];
-                piece && typeid(*piece) == typeid(Knight) &&
-                piece->colour != this->colour)
-                return true;
-
-        if (file < 6)
-            if (Piece const *piece = k_pieces[k_board[rank + 1][file + 2]];
-                piece && typeid(*piece) == typeid(Knight) &&
-                piece->colour != this->colour)
-                return true;
-
-        if (rank < 6) {
-            if (file >= 1)
-                if (Piece const *piece = k_pieces[k_board[rank + 2][file - 1]];
-                    piece && typeid(*piece) == typeid(Knight) &&
-                    piece->colour != this->colour)
-                    return true;
-
-            if (file < 7)
-                if (Piece const *piece = k_pieces[k_board[rank + 2][file + 1]];
-                    piece && typeid(*piece) == typeid(Knight) &&
-                    piece->colour != this->colour)
-                    return true;
-        }
-    }
+    for (Square const &square : k_knight_attacks[king])
+        if (Piece const *piece = k_pieces[square];
+            piece && typeid(*piece) == typeid(Knight) &&
+            piece->colour != Us)
+            return true;
 
     File left_file = file - 1, right_file = file + 1;
 
@@ -441,7 +381,7 @@ auto King::is_checked() const -> bool {
          k_board | std::views::take(rank) | std::views::reverse) {
         if (!found_file)
             if (Piece const *piece = k_pieces[array[file]]) {
-                if (piece->colour != this->colour &&
+                if (piece->colour != Us &&
                     (typeid(*piece) == typeid(Rook) ||
                      typeid(*piece) == typeid(Queen)))
                     return true;
@@ -451,7 +391,7 @@ auto King::is_checked() const -> bool {
 
         if (!found_left && left_file >= 0) {
             if (Piece const *piece = k_pieces[array[left_file]]) {
-                if (piece->colour != this->colour &&
+                if (piece->colour != Us &&
                     (typeid(*piece) == typeid(Bishop) ||
                      typeid(*piece) == typeid(Queen)))
                     return true;
@@ -466,7 +406,7 @@ auto King::is_checked() const -> bool {
             Square const &square = array[right_file];
 
             if (Piece const *piece = k_pieces[square]) {
-                if (piece->colour != this->colour &&
+                if (piece->colour != Us &&
                     (typeid(*piece) == typeid(Bishop) ||
                      typeid(*piece) == typeid(Queen)))
                     return true;
@@ -486,7 +426,7 @@ auto King::is_checked() const -> bool {
          k_board | std::views::drop(rank + 1)) {
         if (!found_file)
             if (Piece const *piece = k_pieces[array[file]]) {
-                if (piece->colour != this->colour &&
+                if (piece->colour != Us &&
                     (typeid(*piece) == typeid(Rook) ||
                      typeid(*piece) == typeid(Queen)))
                     return true;
@@ -496,7 +436,7 @@ auto King::is_checked() const -> bool {
 
         if (!found_left && left_file >= 0) {
             if (Piece const *piece = k_pieces[array[left_file]]) {
-                if (piece->colour != this->colour &&
+                if (piece->colour != Us &&
                     (typeid(*piece) == typeid(Bishop) ||
                      typeid(*piece) == typeid(Queen)))
                     return true;
@@ -509,7 +449,7 @@ auto King::is_checked() const -> bool {
 
         if (!found_right && right_file < 8) {
             if (Piece const *piece = k_pieces[array[right_file]]) {
-                if (piece->colour != this->colour &&
+                if (piece->colour != Us &&
                     (typeid(*piece) == typeid(Bishop) ||
                      typeid(*piece) == typeid(Queen)))
                     return true;
@@ -528,7 +468,7 @@ auto King::is_checked() const -> bool {
         if (!piece)
             continue;
 
-        if (piece->colour != this->colour &&
+        if (piece->colour != Us &&
             (typeid(*piece) == typeid(Rook) || typeid(*piece) == typeid(Queen)))
             return true;
 
@@ -541,7 +481,7 @@ auto King::is_checked() const -> bool {
         if (!piece)
             continue;
 
-        if (piece->colour != this->colour &&
+        if (piece->colour != Us &&
             (typeid(*piece) == typeid(Rook) || typeid(*piece) == typeid(Queen)))
             return true;
 
@@ -549,4 +489,7 @@ auto King::is_checked() const -> bool {
     }
 
     return false;
-}
\ No newline at end of file
+}
+
+template auto King::is_checked<Colour::white>() const -> bool;
+template auto King::is_checked<Colour::black>() const -> bool;
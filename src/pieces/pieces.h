@@ -2,6 +2,7 @@
 #define PIECES_H
 
 #include "../colour.h"
+#include "../piece_type.h"
 
 #include <set>
 
@@ -15,6 +16,10 @@ struct Piece {
 
     virtual ~Piece() = default;
 
+    [[nodiscard]] static auto create(PieceType type, Colour colour) -> Piece *;
+
+    [[nodiscard]] virtual auto type() const -> PieceType = 0;
+
     [[nodiscard]] virtual auto get_moves(Square const &current_square)
         -> std::set<Move> = 0;
 };
@@ -25,13 +30,21 @@ struct Pawn final : Piece {
     bool moved = false;
     bool can_be_en_passanted = false;
 
+    [[nodiscard]] auto type() const -> PieceType override;
+
     [[nodiscard]] auto get_moves(Square const &current_square)
         -> std::set<Move> override;
+
+    template <Colour Us>
+    [[nodiscard]] auto get_moves(Square const &current_square)
+        -> std::set<Move>;
 };
 
 struct Knight final : Piece {
     using Piece::Piece;
 
+    [[nodiscard]] auto type() const -> PieceType override;
+
     [[nodiscard]] auto get_moves(Square const &current_square)
         -> std::set<Move> override;
 };
@@ -39,6 +52,8 @@ struct Knight final : Piece {
 struct Bishop final : Piece {
     using Piece::Piece;
 
+    [[nodiscard]] auto type() const -> PieceType override;
+
     [[nodiscard]] auto get_moves(Square const &current_square)
         -> std::set<Move> override;
 };
@@ -48,6 +63,8 @@ struct Rook final : Piece {
 
     bool can_castle = true;
 
+    [[nodiscard]] auto type() const -> PieceType override;
+
     [[nodiscard]] auto get_moves(Square const &current_square)
         -> std::set<Move> override;
 };
@@ -55,6 +72,8 @@ struct Rook final : Piece {
 struct Queen final : Piece {
     using Piece::Piece;
 
+    [[nodiscard]] auto type() const -> PieceType override;
+
     [[nodiscard]] auto get_moves(Square const &current_square)
         -> std::set<Move> override;
 };
@@ -64,10 +83,18 @@ struct King final : Piece {
 
     bool moved = false;
 
+    [[nodiscard]] auto type() const -> PieceType override;
+
     [[nodiscard]] auto get_moves(Square const &current_square)
         -> std::set<Move> override;
 
+    template <Colour Us>
+    [[nodiscard]] auto get_moves(Square const &current_square)
+        -> std::set<Move>;
+
     [[nodiscard]] auto is_checked() const -> bool;
+
+    template <Colour Us> [[nodiscard]] auto is_checked() const -> bool;
 };
 
 #endif // PIECES_H
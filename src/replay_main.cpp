@@ -0,0 +1,114 @@
+#include "ui/replay.h"
+#include "ui/window.h"
+
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <qapplication.h>
+#include <qtest.h>
+
+static std::string_view constexpr k_usage =
+    "usage: chess-replay --script FILE [--repeat N]\n";
+
+template <typename Number>
+static auto parse(std::string_view const text, Number &number) -> bool {
+    auto const [end, error] =
+        std::from_chars(text.data(), text.data() + text.size(), number);
+
+    return error == std::errc{} && end == text.data() + text.size();
+}
+
+static void print(std::string_view const name, Latencies const &latencies) {
+    std::cout << std::format(
+        "{:<12}{:>10}{:>10}{:>12.3f}{:>12.3f}{:>12.3f}{:>12.3f}\n", name,
+        latencies.actions, latencies.dropped, latencies.p50, latencies.p95,
+        latencies.p99, latencies.max
+    );
+}
+
+std::int32_t main(std::int32_t argc, char *argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+
+    char const *path = nullptr;
+    std::int32_t repeat = 1;
+
+    for (std::int32_t i = 1; i < argc; ++i) {
+        std::string_view const argument = argv[i];
+        bool parsed = i + 1 < argc;
+
+        if (argument == "--script" && parsed) {
+            path = argv[++i];
+        } else if (argument == "--repeat" && parsed) {
+            parsed = parse(argv[++i], repeat) && repeat > 0;
+        } else {
+            parsed = false;
+        }
+
+        if (!parsed) {
+            std::cerr << k_usage;
+
+            return 1;
+        }
+    }
+
+    if (!path) {
+        std::cerr << k_usage;
+
+        return 1;
+    }
+
+    std::ifstream file(path);
+    std::stringstream text;
+
+    text << file.rdbuf();
+
+    std::optional<Script> const script = parse_script(text.str());
+
+    if (!file || !script) {
+        std::cerr << std::format("cannot read script {}\n", path);
+
+        return 1;
+    }
+
+    MainWindow window;
+    window.show();
+
+    if (!QTest::qWaitForWindowExposed(&window)) {
+        std::cerr << "window was never exposed\n";
+
+        return 1;
+    }
+
+    ReplayHarness harness(window);
+
+    std::vector<std::chrono::nanoseconds> all;
+    std::size_t dropped = 0;
+
+    std::cout << std::format(
+        "{:<12}{:>10}{:>10}{:>12}{:>12}{:>12}{:>12}\n", "game", "actions",
+        "dropped", "p50 ms", "p95 ms", "p99 ms", "max ms"
+    );
+
+    for (std::int32_t round = 0; round < repeat; ++round)
+        for (std::size_t game = 0; game < script->size(); ++game) {
+            Latencies const latencies = harness.play((*script)[game], all);
+
+            print(std::format("{}", game + 1), latencies);
+
+            dropped += latencies.dropped;
+        }
+
+    print("total", summarise_latencies(std::move(all), dropped));
+
+    return 0;
+}
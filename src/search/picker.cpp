@@ -0,0 +1,255 @@
+#include "picker.h"
+
+#include "../board/board.h"
+#include "../pieces/pieces.h"
+#include "../vars.h"
+#include "see.h"
+
+#include <algorithm>
+#include <ranges>
+#include <utility>
+
+static std::array<std::int32_t, 6> constexpr k_order_values{
+    1, 3, 3, 5, 9, 0,
+};
+
+static auto is_legal(Move const &move) -> bool {
+    Piece *piece = k_pieces[move.start];
+
+    if (move.start == move.end || !piece ||
+        piece->colour != k_current_player)
+        return false;
+
+    if (!is_promotion(move) && move.promotion != PieceType::queen)
+        return false;
+
+    return piece->get_moves(move.start).contains({move.start, move.end});
+}
+
+static auto value(PieceType const type) -> std::int32_t {
+    return k_order_values[static_cast<std::size_t>(type)];
+}
+
+static auto losing(Move const &move, Piece const *victim) -> bool {
+    Piece const *attacker = k_pieces[move.start];
+
+    if (victim && value(victim->type()) >= value(attacker->type()))
+        return false;
+
+    return see(move) < 0;
+}
+
+static void split_captures(
+    Move const &hash_move, std::vector<Move> &captures,
+    std::vector<Move> &losing_captures
+) {
+    std::vector<std::pair<std::int32_t, Move>> scored;
+    std::vector<std::pair<std::int32_t, Move>> losing_scored;
+
+    for (Move const &move : capture_moves()) {
+        if (move == hash_move)
+            continue;
+
+        Piece const *victim = k_pieces[move.end];
+
+        std::int32_t const score =
+            !victim && is_promotion(move)
+                ? value(move.promotion)
+                : value(victim ? victim->type() : PieceType::pawn) * 16 -
+                      value(k_pieces[move.start]->type());
+
+        (losing(move, victim) ? losing_scored : scored)
+            .emplace_back(score, move);
+    }
+
+    for (auto [list, moves] :
+         {std::pair{&scored, &captures},
+          std::pair{&losing_scored, &losing_captures}}) {
+        std::ranges::stable_sort(
+            *list, std::ranges::greater{},
+            &std::pair<std::int32_t, Move>::first
+        );
+
+        *moves = *list | std::views::values | std::ranges::to<std::vector>();
+    }
+}
+
+static auto is_quiet(Move const &move) -> bool {
+    Piece const *piece = k_pieces[move.start];
+
+    return piece && !k_pieces[move.end] && !is_promotion(move) &&
+           (piece->type() != PieceType::pawn ||
+            move.start.file() == move.end.file());
+}
+
+static auto take_killer(Move &killer, Move const &hash_move) -> bool {
+    if (killer != hash_move && is_quiet(killer) && is_legal(killer))
+        return true;
+
+    killer = {};
+
+    return false;
+}
+
+static auto ordered_quiets(
+    Move const &hash_move, std::array<Move, 2> const &killers,
+    History const &history
+) -> std::vector<Move> {
+    std::vector<Move> quiets = quiet_moves();
+
+    std::erase_if(quiets, [&hash_move, &killers](Move const &move) -> bool {
+        return move == hash_move || move == killers[0] || move == killers[1];
+    });
+
+    std::ranges::stable_sort(
+        quiets, std::ranges::greater{},
+        [&history](Move const &move) -> std::int32_t {
+            return history[move.start * 64 + move.end];
+        }
+    );
+
+    return quiets;
+}
+
+MovePicker::Iterator::Iterator(MovePicker &picker)
+    : picker(&picker), move(picker.next()) {}
+
+auto MovePicker::Iterator::operator*() const -> Move const & {
+    return *this->move;
+}
+
+auto MovePicker::Iterator::operator++() -> Iterator & {
+    this->move = this->picker->next();
+
+    return *this;
+}
+
+void MovePicker::Iterator::operator++(std::int32_t) { ++*this; }
+
+auto MovePicker::Iterator::operator==(Sentinel) const -> bool {
+    return !this->move;
+}
+
+MovePicker::MovePicker(
+    Move const &hash_move, std::array<Move, 2> const &killers,
+    History const &history
+)
+    : hash_move(hash_move), killers(killers), history(history) {}
+
+auto MovePicker::next() -> std::optional<Move> {
+    switch (this->stage) {
+    case Stage::hash:
+        this->stage = Stage::generate;
+
+        if (is_legal(this->hash_move))
+            return this->hash_move;
+
+        [[fallthrough]];
+    case Stage::generate:
+        split_captures(this->hash_move, this->captures, this->losing_captures);
+
+        this->stage = Stage::captures;
+
+        [[fallthrough]];
+    case Stage::captures:
+        while (this->index < this->captures.size())
+            if (Move const &move = this->captures[this->index++];
+                move.is_valid())
+                return move;
+
+        this->index = 0;
+        this->stage = Stage::killers;
+
+        [[fallthrough]];
+    case Stage::killers:
+        while (this->index < this->killers.size())
+            if (Move &killer = this->killers[this->index++];
+                take_killer(killer, this->hash_move))
+                return killer;
+
+        this->stage = Stage::order;
+
+        [[fallthrough]];
+    case Stage::order:
+        this->quiets =
+            ordered_quiets(this->hash_move, this->killers, this->history);
+
+        this->index = 0;
+        this->stage = Stage::quiets;
+
+        [[fallthrough]];
+    case Stage::quiets:
+        while (this->index < this->quiets.size())
+            if (Move const &move = this->quiets[this->index++];
+                move.is_valid())
+                return move;
+
+        this->index = 0;
+        this->stage = Stage::losing;
+
+        [[fallthrough]];
+    case Stage::losing:
+        while (this->index < this->losing_captures.size())
+            if (Move const &move = this->losing_captures[this->index++];
+                move.is_valid())
+                return move;
+
+        this->stage = Stage::done;
+
+        [[fallthrough]];
+    case Stage::done:
+        break;
+    }
+
+    return std::nullopt;
+}
+
+auto MovePicker::begin() -> Iterator { return Iterator(*this); }
+
+auto MovePicker::end() const -> Sentinel { return {}; }
+
+#if defined(CHESS_COROUTINES) && defined(__cpp_lib_generator)
+auto staged_moves(
+    Move const hash_move, std::array<Move, 2> killers, History const &history
+) -> StagedMoves {
+    if (is_legal(hash_move))
+        co_yield hash_move;
+
+    std::vector<Move> captures;
+    std::vector<Move> losing_captures;
+
+    split_captures(hash_move, captures, losing_captures);
+
+    for (Move const &move : captures)
+        if (move.is_valid())
+            co_yield move;
+
+    for (Move &killer : killers)
+        if (take_killer(killer, hash_move))
+            co_yield killer;
+
+    for (Move const &move : ordered_quiets(hash_move, killers, history))
+        if (move.is_valid())
+            co_yield move;
+
+    for (Move const &move : losing_captures)
+        if (move.is_valid())
+            co_yield move;
+}
+#else
+auto staged_moves(
+    Move const &hash_move, std::array<Move, 2> const &killers,
+    History const &history
+) -> StagedMoves {
+    return {hash_move, killers, history};
+}
+#endif
+
+auto good_captures() -> std::vector<Move> {
+    std::vector<Move> captures;
+    std::vector<Move> losing_captures;
+
+    split_captures({}, captures, losing_captures);
+
+    return captures;
+}
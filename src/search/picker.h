@@ -0,0 +1,96 @@
+#ifndef PICKER_H
+#define PICKER_H
+
+#include "../move/move.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <vector>
+
+#if defined(CHESS_COROUTINES) && __has_include(<generator>)
+#include <generator>
+#endif
+
+using History = std::array<std::int32_t, 64 * 64>;
+
+class MovePicker final {
+  public:
+    struct Sentinel final {};
+
+    class Iterator final {
+      public:
+        using value_type = Move;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+
+        explicit Iterator(MovePicker &picker);
+
+        [[nodiscard]] auto operator*() const -> Move const &;
+
+        auto operator++() -> Iterator &;
+
+        void operator++(std::int32_t);
+
+        [[nodiscard]] auto operator==(Sentinel) const -> bool;
+
+      private:
+        MovePicker *picker = nullptr;
+        std::optional<Move> move;
+    };
+
+    MovePicker(
+        Move const &hash_move, std::array<Move, 2> const &killers,
+        History const &history
+    );
+
+    [[nodiscard]] auto next() -> std::optional<Move>;
+
+    [[nodiscard]] auto begin() -> Iterator;
+
+    [[nodiscard]] auto end() const -> Sentinel;
+
+  private:
+    enum class Stage : std::uint8_t {
+        hash,
+        generate,
+        captures,
+        killers,
+        order,
+        quiets,
+        losing,
+        done,
+    };
+
+    Move hash_move;
+    std::array<Move, 2> killers;
+    History const &history;
+
+    Stage stage = Stage::hash;
+    std::vector<Move> captures;
+    std::vector<Move> losing_captures;
+    std::vector<Move> quiets;
+    std::size_t index = 0;
+};
+
+#if defined(CHESS_COROUTINES) && defined(__cpp_lib_generator)
+using StagedMoves = std::generator<Move const &>;
+
+[[nodiscard]] auto staged_moves(
+    Move hash_move, std::array<Move, 2> killers, History const &history
+) -> StagedMoves;
+#else
+using StagedMoves = MovePicker;
+
+[[nodiscard]] auto staged_moves(
+    Move const &hash_move, std::array<Move, 2> const &killers,
+    History const &history
+) -> StagedMoves;
+#endif
+
+[[nodiscard]] auto good_captures() -> std::vector<Move>;
+
+#endif // PICKER_H
@@ -0,0 +1,317 @@
+#include "search.h"
+
+#include "../board/board.h"
+#include "../nnue/nnue.h"
+#include "../pieces/pieces.h"
+#include "../stats/stats.h"
+#include "../stats/trace.h"
+#include "../vars.h"
+#include "picker.h"
+
+#include <algorithm>
+
+static auto to_table(Score const score, std::int32_t const ply) -> Score {
+    if (score >= k_mate - k_max_ply)
+        return score + ply;
+
+    if (score <= -k_mate + k_max_ply)
+        return score - ply;
+
+    return score;
+}
+
+static auto from_table(Score const score, std::int32_t const ply) -> Score {
+    if (score >= k_mate - k_max_ply)
+        return score - ply;
+
+    if (score <= -k_mate + k_max_ply)
+        return score + ply;
+
+    return score;
+}
+
+Searcher::Searcher(TranspositionTable &table, Signals &signals)
+    : table(table), signals(signals) {}
+
+auto Searcher::search(
+    Limits const &limits, std::function<void(Info const &)> const &report
+) -> Result {
+    this->limits = limits;
+    this->start = Clock::now();
+    this->pondering = false;
+    this->stopped = false;
+    this->node_count.store(0, std::memory_order::relaxed);
+    this->killers = {};
+    this->history = {};
+
+    Result result;
+
+    std::vector<Move> const moves = legal_moves();
+
+    if (!moves.empty())
+        result.pv = {moves.front()};
+
+    this->time.start(limits, k_current_player, moves.size());
+
+    for (std::int32_t depth = 1; depth <= limits.depth; ++depth) {
+        TraceSpan const span("search/iteration");
+
+        std::vector<Move> pv;
+        std::uint64_t const before = this->nodes();
+
+        this->best_nodes = 0;
+
+        Score const score =
+            this->negamax(depth, -k_infinity, k_infinity, 0, pv);
+
+        if (this->stopped && pv.empty())
+            break;
+
+        result.pv = pv;
+        result.score = score;
+        result.depth = depth;
+
+        if (this->stopped)
+            break;
+
+        if (!pv.empty())
+            this->time.update(
+                pv.front(), score,
+                static_cast<double>(this->best_nodes) /
+                    static_cast<double>(std::max<std::uint64_t>(
+                        this->nodes() - before, 1
+                    ))
+            );
+
+        if (report)
+            report({
+                .depth = depth,
+                .score = score,
+                .nodes = this->nodes(),
+                .elapsed = this->elapsed(),
+                .pv = pv,
+            });
+
+        if (this->signals.ponder.load(std::memory_order::relaxed) ||
+            limits.infinite)
+            continue;
+
+        if (this->time.exhausted(this->elapsed()))
+            break;
+
+        if (std::abs(score) >= k_mate - depth)
+            break;
+    }
+
+    result.nodes = this->nodes();
+
+    return result;
+}
+
+auto Searcher::nodes() const -> std::uint64_t {
+    return this->node_count.load(std::memory_order::relaxed);
+}
+
+auto Searcher::negamax(
+    std::int32_t depth, Score alpha, Score const beta, std::int32_t const ply,
+    std::vector<Move> &pv
+) -> Score {
+    pv.clear();
+
+    if (this->should_stop())
+        return 0;
+
+    this->node_count.store(this->nodes() + 1, std::memory_order::relaxed);
+
+    count(Counter::nodes);
+
+    if (ply > 0 && (is_repetition(1) || is_draw()))
+        return 0;
+
+    bool const checked = in_check();
+
+    if (checked)
+        ++depth;
+
+    if (ply >= k_max_ply - 1)
+        return evaluate();
+
+    if (depth <= 0)
+        return this->quiescence(alpha, beta, ply);
+
+    Score const original_alpha = alpha;
+
+    Move tt_move{};
+
+    if (std::optional<Entry> const entry = this->table.probe(k_hash)) {
+        tt_move = entry->move.decode();
+
+        if (Score const score = from_table(entry->score, ply);
+            ply > 0 && entry->depth >= depth &&
+            (entry->bound == Bound::exact ||
+             (entry->bound == Bound::lower && score >= beta) ||
+             (entry->bound == Bound::upper && score <= alpha)))
+            return score;
+    }
+
+    Move best_move{};
+    Score best = -k_infinity;
+
+    std::vector<Move> child_pv;
+    std::size_t searched = 0;
+
+    for (Move const &move : staged_moves(
+             tt_move, this->killers[ply],
+             this->history[static_cast<std::size_t>(k_current_player)]
+         )) {
+        bool const quiet = !k_pieces[move.end] && !is_promotion(move);
+        std::uint64_t const before = this->nodes();
+
+        Undo const undo = move.make();
+
+        Score score;
+
+        if (searched++ == 0) {
+            score = -this->negamax(depth - 1, -beta, -alpha, ply + 1, child_pv);
+        } else {
+            score = -this->negamax(
+                depth - 1, -alpha - 1, -alpha, ply + 1, child_pv
+            );
+
+            if (score > alpha && score < beta)
+                score =
+                    -this->negamax(depth - 1, -beta, -alpha, ply + 1, child_pv);
+        }
+
+        move.unmake(undo);
+
+        if (this->stopped)
+            return ply == 0 ? best : 0;
+
+        if (score <= best)
+            continue;
+
+        best = score;
+        best_move = move;
+
+        if (ply == 0)
+            this->best_nodes = this->nodes() - before;
+
+        if (score <= alpha)
+            continue;
+
+        alpha = score;
+
+        pv.assign(1, move);
+        pv.insert(pv.end(), child_pv.cbegin(), child_pv.cend());
+
+        if (alpha < beta)
+            continue;
+
+        if (quiet) {
+            std::array<Move, 2> &killers = this->killers[ply];
+
+            if (killers[0] != move) {
+                killers[1] = killers[0];
+                killers[0] = move;
+            }
+
+            this->history[static_cast<std::size_t>(k_current_player)]
+                         [move.start * 64 + move.end] += depth * depth;
+        }
+
+        break;
+    }
+
+    if (!searched)
+        return checked ? -k_mate + ply : 0;
+
+    this->table.store(
+        k_hash, {
+                    .move = PackedMove::encode(best_move),
+                    .score = to_table(best, ply),
+                    .depth = depth,
+                    .bound = best >= beta            ? Bound::lower
+                             : best > original_alpha ? Bound::exact
+                                                     : Bound::upper,
+                }
+    );
+
+    return best;
+}
+
+auto Searcher::quiescence(Score alpha, Score const beta, std::int32_t const ply)
+    -> Score {
+    if (this->should_stop())
+        return 0;
+
+    this->node_count.store(this->nodes() + 1, std::memory_order::relaxed);
+
+    count(Counter::nodes);
+
+    Score best = evaluate();
+
+    if (best >= beta || ply >= k_max_ply - 1)
+        return best;
+
+    alpha = std::max(alpha, best);
+
+    for (Move const &move : good_captures()) {
+        if (!move.is_valid())
+            continue;
+
+        Undo const undo = move.make();
+
+        Score const score = -this->quiescence(-beta, -alpha, ply + 1);
+
+        move.unmake(undo);
+
+        if (this->stopped)
+            return 0;
+
+        if (score <= best)
+            continue;
+
+        best = score;
+
+        if (score >= beta)
+            break;
+
+        alpha = std::max(alpha, score);
+    }
+
+    return best;
+}
+
+auto Searcher::elapsed() const -> std::chrono::milliseconds {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        Clock::now() - this->start
+    );
+}
+
+auto Searcher::should_stop() -> bool {
+    using namespace std::chrono_literals;
+
+    if (this->stopped)
+        return true;
+
+    if (this->signals.stop.load(std::memory_order::relaxed) ||
+        (this->limits.nodes && this->nodes() >= this->limits.nodes))
+        return this->stopped = true;
+
+    if (this->time.maximum() == 0ms || this->nodes() % 64)
+        return false;
+
+    if (this->signals.ponder.load(std::memory_order::relaxed)) {
+        this->pondering = true;
+
+        return false;
+    }
+
+    if (this->pondering) {
+        this->pondering = false;
+        this->start = Clock::now();
+    }
+
+    return this->stopped = this->elapsed() >= this->time.maximum();
+}
@@ -0,0 +1,94 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "../eval/tables.h"
+#include "../move/move.h"
+#include "table.h"
+#include "timing.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+inline static std::int32_t constexpr k_max_ply = 128;
+inline static Score constexpr k_infinity = 32000;
+inline static Score constexpr k_mate = 31000;
+
+struct Limits final {
+    std::int32_t depth = k_max_ply - 1;
+    std::uint64_t nodes = 0;
+    std::chrono::milliseconds movetime{};
+    std::array<std::chrono::milliseconds, 2> time{};
+    std::array<std::chrono::milliseconds, 2> increment{};
+    std::int32_t moves_to_go = 0;
+    std::chrono::milliseconds overhead{20};
+    std::chrono::milliseconds cap{};
+    bool infinite = false;
+};
+
+struct Signals final {
+    std::atomic<bool> stop = false;
+    std::atomic<bool> ponder = false;
+};
+
+struct Info final {
+    std::int32_t depth;
+    Score score;
+    std::uint64_t nodes;
+    std::chrono::milliseconds elapsed;
+    std::vector<Move> pv;
+};
+
+struct Result final {
+    std::vector<Move> pv;
+    Score score = 0;
+    std::int32_t depth = 0;
+    std::uint64_t nodes = 0;
+};
+
+class Searcher final {
+  public:
+    Searcher(TranspositionTable &table, Signals &signals);
+
+    [[nodiscard]] auto search(
+        Limits const &limits,
+        std::function<void(Info const &)> const &report = {}
+    ) -> Result;
+
+    [[nodiscard]] auto nodes() const -> std::uint64_t;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    TranspositionTable &table;
+    Signals &signals;
+
+    Limits limits;
+    Clock::time_point start;
+    TimeManager time;
+    bool pondering = false;
+    bool stopped = false;
+
+    std::atomic<std::uint64_t> node_count = 0;
+    std::uint64_t best_nodes = 0;
+
+    std::array<std::array<Move, 2>, k_max_ply> killers{};
+    std::array<std::array<std::int32_t, 64 * 64>, 2> history{};
+
+    [[nodiscard]] auto negamax(
+        std::int32_t depth, Score alpha, Score beta, std::int32_t ply,
+        std::vector<Move> &pv
+    ) -> Score;
+
+    [[nodiscard]] auto quiescence(Score alpha, Score beta, std::int32_t ply)
+        -> Score;
+
+    [[nodiscard]] auto elapsed() const -> std::chrono::milliseconds;
+
+    [[nodiscard]] auto should_stop() -> bool;
+};
+
+#endif // SEARCH_H
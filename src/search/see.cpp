@@ -0,0 +1,160 @@
+#include "see.h"
+
+#include "../board/board.h"
+#include "../pieces/pieces.h"
+#include "../vars.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+
+using Occupancy = std::uint64_t;
+
+static Score constexpr k_king_value = 20000;
+
+static std::array<std::pair<Rank, File>, 4> constexpr k_straight{{
+    {-1, 0},
+    {1, 0},
+    {0, -1},
+    {0, 1},
+}};
+static std::array<std::pair<Rank, File>, 4> constexpr k_diagonal{{
+    {-1, -1},
+    {-1, 1},
+    {1, -1},
+    {1, 1},
+}};
+
+static auto bit(Square const &square) -> Occupancy {
+    return Occupancy{1} << square;
+}
+
+static auto value(PieceType const type) -> Score {
+    return type == PieceType::king
+               ? k_king_value
+               : k_middlegame_values[static_cast<std::size_t>(type)];
+}
+
+static auto occupancy() -> Occupancy {
+    Occupancy occupied = 0;
+
+    for (Square const &square : k_squares)
+        if (k_pieces[square])
+            occupied |= bit(square);
+
+    return occupied;
+}
+
+static auto slider(
+    Square const &target, Occupancy const occupied, Colour const side,
+    std::array<std::pair<Rank, File>, 4> const &directions,
+    PieceType const type
+) -> Square {
+    for (auto const &[rank_step, file_step] : directions)
+        for (Rank rank = target.rank() + rank_step,
+                  file = target.file() + file_step;
+             rank >= 0 && rank < 8 && file >= 0 && file < 8;
+             rank += rank_step, file += file_step) {
+            Square const &square = k_board[rank][file];
+
+            if (!(occupied & bit(square)))
+                continue;
+
+            if (Piece const *piece = k_pieces[square];
+                piece->colour == side && piece->type() == type)
+                return square;
+
+            break;
+        }
+
+    return k_no_square;
+}
+
+static auto least_valuable(
+    Square const &target, Occupancy const occupied, Colour const side
+) -> Square {
+    auto const matches = [occupied, side](
+                             Square const &square, PieceType const type
+                         ) -> bool {
+        Piece const *piece = k_pieces[square];
+
+        return occupied & bit(square) && piece->colour == side &&
+               piece->type() == type;
+    };
+
+    for (Square const &square :
+         k_pawn_attacks[static_cast<std::size_t>(side) ^ 1][target])
+        if (matches(square, PieceType::pawn))
+            return square;
+
+    for (Square const &square : k_knight_attacks[target])
+        if (matches(square, PieceType::knight))
+            return square;
+
+    for (auto const &[directions, type] : {
+             std::pair{&k_diagonal, PieceType::bishop},
+             std::pair{&k_straight, PieceType::rook},
+             std::pair{&k_diagonal, PieceType::queen},
+             std::pair{&k_straight, PieceType::queen},
+         })
+        if (Square const square =
+                slider(target, occupied, side, *directions, type);
+            square != k_no_square)
+            return square;
+
+    for (Square const &square : k_king_attacks[target])
+        if (matches(square, PieceType::king))
+            return square;
+
+    return k_no_square;
+}
+
+auto see(Move const &move) -> Score {
+    Piece const *mover = k_pieces[move.start];
+    Piece const *victim = k_pieces[move.end];
+
+    Occupancy occupied = occupancy() & ~bit(move.start);
+
+    std::array<Score, 32> gains{};
+
+    if (victim) {
+        gains[0] = value(victim->type());
+    } else if (mover->type() == PieceType::pawn &&
+               move.start.file() != move.end.file()) {
+        gains[0] = value(PieceType::pawn);
+        occupied &= ~bit(k_board[move.start.rank()][move.end.file()]);
+    }
+
+    Score attacker = value(mover->type());
+
+    if (is_promotion(move)) {
+        attacker = value(move.promotion);
+        gains[0] += attacker - value(PieceType::pawn);
+    }
+
+    Colour side =
+        mover->colour == Colour::white ? Colour::black : Colour::white;
+    std::size_t depth = 0;
+
+    while (depth + 1 < gains.size()) {
+        Square const square = least_valuable(move.end, occupied, side);
+
+        if (square == k_no_square)
+            break;
+
+        ++depth;
+        gains[depth] = attacker - gains[depth - 1];
+
+        occupied &= ~bit(square);
+        attacker = value(k_pieces[square]->type());
+        side = side == Colour::white ? Colour::black : Colour::white;
+    }
+
+    for (; depth > 0; --depth)
+        gains[depth - 1] = -std::max(-gains[depth - 1], gains[depth]);
+
+    return gains[0];
+}
@@ -0,0 +1,9 @@
+#ifndef SEE_H
+#define SEE_H
+
+#include "../eval/tables.h"
+#include "../move/move.h"
+
+[[nodiscard]] auto see(Move const &move) -> Score;
+
+#endif // SEE_H
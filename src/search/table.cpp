@@ -0,0 +1,89 @@
+#include "table.h"
+
+#include "../stats/stats.h"
+
+#include <algorithm>
+
+static auto pack(Entry const &entry) -> std::uint64_t {
+    return static_cast<std::uint64_t>(entry.move.data) |
+           static_cast<std::uint64_t>(static_cast<std::uint16_t>(entry.score))
+               << 16 |
+           static_cast<std::uint64_t>(static_cast<std::uint8_t>(entry.depth))
+               << 32 |
+           static_cast<std::uint64_t>(entry.bound) << 40;
+}
+
+static auto unpack(std::uint64_t const data) -> Entry {
+    return {
+        .move = {static_cast<std::uint16_t>(data & 0xFFFF)},
+        .score = static_cast<std::int16_t>(data >> 16 & 0xFFFF),
+        .depth = static_cast<std::int8_t>(data >> 32 & 0xFF),
+        .bound = static_cast<Bound>(data >> 40 & 3),
+    };
+}
+
+TranspositionTable::TranspositionTable(std::size_t const megabytes) {
+    this->resize(megabytes);
+}
+
+void TranspositionTable::resize(std::size_t const megabytes) {
+    this->size = std::max<std::size_t>(
+        megabytes * 1024 * 1024 / sizeof(Slot), 1
+    );
+    this->slots = std::make_unique<Slot[]>(this->size);
+}
+
+void TranspositionTable::clear() {
+    for (std::size_t index = 0; index < this->size; ++index) {
+        this->slots[index].key.store(0, std::memory_order::relaxed);
+        this->slots[index].data.store(0, std::memory_order::relaxed);
+    }
+}
+
+auto TranspositionTable::probe(Hash const hash) const -> std::optional<Entry> {
+    count(Counter::hash_probes);
+
+    Slot const &slot = this->slot(hash);
+
+    std::uint64_t const data = slot.data.load(std::memory_order::relaxed);
+
+    if (!data || (slot.key.load(std::memory_order::relaxed) ^ data) != hash)
+        return std::nullopt;
+
+    count(Counter::hash_hits);
+
+    return unpack(data);
+}
+
+void TranspositionTable::store(Hash const hash, Entry const &entry) {
+    Slot &slot = this->slot(hash);
+
+    std::uint64_t const old = slot.data.load(std::memory_order::relaxed);
+
+    if ((slot.key.load(std::memory_order::relaxed) ^ old) == hash &&
+        entry.bound != Bound::exact && unpack(old).depth > entry.depth + 2)
+        return;
+
+    std::uint64_t const data = pack(entry);
+
+    slot.key.store(hash ^ data, std::memory_order::relaxed);
+    slot.data.store(data, std::memory_order::relaxed);
+}
+
+auto TranspositionTable::hashfull() const -> std::int32_t {
+    std::size_t const sample = std::min<std::size_t>(this->size, 1000);
+
+    std::int32_t used = 0;
+
+    for (std::size_t index = 0; index < sample; ++index)
+        if (this->slots[index].data.load(std::memory_order::relaxed))
+            ++used;
+
+    return static_cast<std::int32_t>(used * 1000 / sample);
+}
+
+auto TranspositionTable::slot(Hash const hash) const -> Slot & {
+    return this->slots[static_cast<std::size_t>(
+        static_cast<unsigned __int128>(hash) * this->size >> 64
+    )];
+}
@@ -0,0 +1,49 @@
+#ifndef TABLE_H
+#define TABLE_H
+
+#include "../board/zobrist.h"
+#include "../eval/tables.h"
+#include "../move/move.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+enum class Bound : std::uint8_t { none, upper, lower, exact };
+
+struct Entry final {
+    PackedMove move;
+    Score score;
+    std::int32_t depth;
+    Bound bound;
+};
+
+class TranspositionTable final {
+  public:
+    explicit TranspositionTable(std::size_t megabytes);
+
+    void resize(std::size_t megabytes);
+
+    void clear();
+
+    [[nodiscard]] auto probe(Hash hash) const -> std::optional<Entry>;
+
+    void store(Hash hash, Entry const &entry);
+
+    [[nodiscard]] auto hashfull() const -> std::int32_t;
+
+  private:
+    struct Slot final {
+        std::atomic<Hash> key;
+        std::atomic<std::uint64_t> data;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    std::size_t size = 0;
+
+    [[nodiscard]] auto slot(Hash hash) const -> Slot &;
+};
+
+#endif // TABLE_H
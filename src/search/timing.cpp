@@ -0,0 +1,99 @@
+#include "timing.h"
+
+#include "search.h"
+
+#include <algorithm>
+
+using namespace std::chrono_literals;
+
+static std::int32_t constexpr k_default_moves_to_go = 30;
+static std::int32_t constexpr k_stable_iterations = 4;
+static double constexpr k_dominant_effort = 0.9;
+
+void TimeManager::start(
+    Limits const &limits, Colour const us, std::size_t const moves
+) {
+    auto const side = static_cast<std::size_t>(us);
+
+    this->optimum_time = this->maximum_time = 0ms;
+    this->fixed = limits.movetime > 0ms;
+    this->forced = moves == 1;
+    this->best = {};
+    this->score = 0;
+    this->iterations = 0;
+    this->stability = 0;
+    this->instability = 0;
+    this->scale = 1;
+
+    if (this->fixed) {
+        this->optimum_time = this->maximum_time =
+            std::max(limits.movetime - limits.overhead, 1ms);
+    } else if (limits.time[side] > 0ms) {
+        std::chrono::milliseconds const remaining =
+            std::max(limits.time[side] - limits.overhead, 1ms);
+        std::int32_t const moves_to_go = limits.moves_to_go > 0
+                                             ? limits.moves_to_go
+                                             : k_default_moves_to_go;
+        std::chrono::milliseconds const ceiling =
+            moves_to_go == 1 ? remaining * 3 / 4 : remaining / 2;
+
+        this->optimum_time = std::min(
+            remaining / moves_to_go + limits.increment[side] * 3 / 4, ceiling
+        );
+        this->maximum_time = std::min(this->optimum_time * 5, ceiling);
+    }
+
+    if (limits.cap > 0ms) {
+        std::chrono::milliseconds const cap =
+            std::max(limits.cap - limits.overhead, 1ms);
+
+        this->maximum_time =
+            this->maximum_time > 0ms ? std::min(this->maximum_time, cap) : cap;
+        this->optimum_time = std::min(
+            this->optimum_time > 0ms ? this->optimum_time : cap, cap
+        );
+    }
+}
+
+void TimeManager::update(
+    Move const &best, Score const score, double const effort
+) {
+    bool const changed = this->iterations > 0 && best != this->best;
+    Score const drop = this->iterations > 0 ? this->score - score : 0;
+
+    this->stability = changed ? 0 : this->stability + 1;
+    this->instability = this->instability / 2 + (changed ? 1 : 0);
+
+    this->scale = (1 + this->instability) *
+                  std::clamp(1 + drop / 100.0, 1.0, 2.0) *
+                  (this->stability >= k_stable_iterations ? 0.6 : 1.0) *
+                  (effort >= k_dominant_effort ? 0.6 : 1.0);
+
+    this->best = best;
+    this->score = score;
+    ++this->iterations;
+}
+
+auto TimeManager::optimum() const -> std::chrono::milliseconds {
+    if (this->fixed)
+        return this->optimum_time;
+
+    return std::min(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            this->optimum_time * this->scale
+        ),
+        this->maximum_time
+    );
+}
+
+auto TimeManager::maximum() const -> std::chrono::milliseconds {
+    return this->maximum_time;
+}
+
+auto TimeManager::exhausted(std::chrono::milliseconds const elapsed) const
+    -> bool {
+    if (this->maximum_time == 0ms)
+        return false;
+
+    return this->forced || elapsed >= this->optimum() / 2;
+}
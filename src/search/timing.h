@@ -0,0 +1,41 @@
+#ifndef TIMING_H
+#define TIMING_H
+
+#include "../colour.h"
+#include "../eval/tables.h"
+#include "../move/move.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+struct Limits;
+
+class TimeManager final {
+  public:
+    void start(Limits const &limits, Colour us, std::size_t moves);
+
+    void update(Move const &best, Score score, double effort);
+
+    [[nodiscard]] auto optimum() const -> std::chrono::milliseconds;
+
+    [[nodiscard]] auto maximum() const -> std::chrono::milliseconds;
+
+    [[nodiscard]] auto exhausted(std::chrono::milliseconds elapsed) const
+        -> bool;
+
+  private:
+    std::chrono::milliseconds optimum_time{};
+    std::chrono::milliseconds maximum_time{};
+    bool fixed = false;
+    bool forced = false;
+
+    Move best{};
+    Score score = 0;
+    std::int32_t iterations = 0;
+    std::int32_t stability = 0;
+    double instability = 0;
+    double scale = 1;
+};
+
+#endif // TIMING_H
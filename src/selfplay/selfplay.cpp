@@ -0,0 +1,158 @@
+#include "selfplay.h"
+
+#include "../board/board.h"
+#include "../search/search.h"
+#include "../vars.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::size_t constexpr k_chunk_bytes = std::size_t{1} << 20;
+static Score constexpr k_adjudicate_score = 1000;
+static std::int32_t constexpr k_adjudicate_plies = 8;
+
+static auto play_game(
+    SelfPlayOptions const &options, Searcher &searcher,
+    std::mt19937_64 &random
+) -> ScoredGame {
+    ScoredGame game;
+
+    (void)load_fen(k_start_fen);
+
+    for (std::int32_t ply = 0; ply < options.random_plies; ++ply) {
+        std::vector<Move> const moves = legal_moves();
+
+        if (moves.empty() || is_draw())
+            return {};
+
+        Move const &move = moves[std::uniform_int_distribution<std::size_t>(
+            0, moves.size() - 1
+        )(random)];
+
+        game.moves.push_back(PackedMove::encode(move));
+
+        play(move);
+    }
+
+    game.opening = static_cast<std::uint32_t>(game.moves.size());
+
+    Limits const limits{.nodes = options.nodes};
+    std::int32_t streak = 0;
+
+    while (true) {
+        if (!has_legal_moves()) {
+            if (in_check())
+                game.result = k_current_player == Colour::white ? 0 : 2;
+
+            return game;
+        }
+
+        if (is_draw() || game.moves.size() >=
+                             static_cast<std::size_t>(options.max_plies))
+            return game;
+
+        Result const found = searcher.search(limits);
+        Score const score = found.score;
+        Move const move = found.pv.front();
+        Score const white = k_current_player == Colour::white ? score : -score;
+
+        streak = white >= k_adjudicate_score
+                     ? std::max(streak, 0) + 1
+                 : white <= -k_adjudicate_score ? std::min(streak, 0) - 1
+                                                : 0;
+
+        game.scores.push_back(score);
+        game.moves.push_back(PackedMove::encode(move));
+
+        play(move);
+
+        if (std::abs(streak) >= k_adjudicate_plies) {
+            game.result = streak > 0 ? 2 : 0;
+
+            return game;
+        }
+    }
+}
+
+auto generate_games(
+    SelfPlayOptions const &options, StreamWriter &writer,
+    std::function<void(SelfPlaySummary const &)> const &report
+) -> SelfPlaySummary {
+    auto const start = std::chrono::steady_clock::now();
+
+    SelfPlaySummary summary;
+
+    std::atomic<std::uint64_t> next = 0;
+    std::mutex mutex;
+
+    auto const flush = [&](std::string &bytes, std::uint32_t &games,
+                           std::uint64_t &positions) -> void {
+        bool const written = writer.append(bytes, games);
+
+        std::lock_guard const lock(mutex);
+
+        summary.games += games;
+        summary.positions += positions;
+        summary.bytes += bytes.size();
+        summary.elapsed = std::chrono::steady_clock::now() - start;
+        summary.failed = summary.failed || !written;
+
+        if (report)
+            report(summary);
+
+        bytes.clear();
+        games = 0;
+        positions = 0;
+    };
+
+    std::vector<std::thread> workers;
+
+    for (std::int32_t i = 0; i < std::max(options.threads, 1); ++i)
+        workers.emplace_back([&options, &next, &flush]() -> void {
+            TranspositionTable table(options.hash);
+            Signals signals;
+            Searcher searcher(table, signals);
+
+            std::string bytes;
+            std::uint32_t games = 0;
+            std::uint64_t positions = 0;
+
+            bytes.reserve(k_chunk_bytes + k_chunk_bytes / 8);
+
+            for (std::uint64_t index = next++; index < options.games;
+                 index = next++) {
+                std::mt19937_64 random(options.seed + index);
+
+                table.clear();
+
+                ScoredGame const game = play_game(options, searcher, random);
+
+                if (game.scores.empty() || !encode_scored_game(game, bytes))
+                    continue;
+
+                ++games;
+                positions += game.scores.size();
+
+                if (bytes.size() >= k_chunk_bytes)
+                    flush(bytes, games, positions);
+            }
+
+            if (games)
+                flush(bytes, games, positions);
+
+            clear_board();
+        });
+
+    for (std::thread &worker : workers)
+        worker.join();
+
+    summary.elapsed = std::chrono::steady_clock::now() - start;
+
+    return summary;
+}
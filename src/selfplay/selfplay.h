@@ -0,0 +1,34 @@
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+
+#include "stream.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+struct SelfPlayOptions final {
+    std::uint64_t games = 1000;
+    std::uint64_t nodes = 5000;
+    std::int32_t threads = 1;
+    std::int32_t random_plies = 8;
+    std::int32_t max_plies = 400;
+    std::size_t hash = 16;
+    std::uint64_t seed = 0;
+};
+
+struct SelfPlaySummary final {
+    std::uint64_t games = 0;
+    std::uint64_t positions = 0;
+    std::uint64_t bytes = 0;
+    std::chrono::nanoseconds elapsed{};
+    bool failed = false;
+};
+
+[[nodiscard]] auto generate_games(
+    SelfPlayOptions const &options, StreamWriter &writer,
+    std::function<void(SelfPlaySummary const &)> const &report = {}
+) -> SelfPlaySummary;
+
+#endif // SELFPLAY_H
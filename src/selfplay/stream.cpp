@@ -0,0 +1,334 @@
+#include "stream.h"
+
+#include "../board/board.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static std::array<char, 4> constexpr k_magic{'C', 'H', 'S', 'P'};
+static std::uint32_t constexpr k_version = 1;
+
+struct Header final {
+    std::array<char, 4> magic = k_magic;
+    std::uint32_t version = k_version;
+};
+
+static_assert(sizeof(Header) == 8);
+
+struct ChunkHeader final {
+    std::uint32_t size = 0;
+    std::uint32_t games = 0;
+};
+
+static_assert(sizeof(ChunkHeader) == 8);
+
+struct Cursor final {
+    std::span<char const> bytes;
+    std::size_t position = 0;
+
+    [[nodiscard]] auto take(std::size_t const size)
+        -> std::optional<std::string_view> {
+        if (this->bytes.size() - this->position < size)
+            return std::nullopt;
+
+        std::string_view const view(this->bytes.data() + this->position, size);
+
+        this->position += size;
+
+        return view;
+    }
+
+    [[nodiscard]] auto varint() -> std::optional<std::uint64_t> {
+        std::uint64_t value = 0;
+
+        for (std::int32_t shift = 0; shift < 64; shift += 7) {
+            std::optional<std::string_view> const byte = this->take(1);
+
+            if (!byte)
+                return std::nullopt;
+
+            auto const bits = static_cast<std::uint8_t>(byte->front());
+
+            value |= static_cast<std::uint64_t>(bits & 127) << shift;
+
+            if (bits < 128)
+                return value;
+        }
+
+        return std::nullopt;
+    }
+};
+
+static void write_varint(std::string &bytes, std::uint64_t value) {
+    for (; value >= 128; value >>= 7)
+        bytes += static_cast<char>((value & 127) | 128);
+
+    bytes += static_cast<char>(value);
+}
+
+static auto zigzag(std::int64_t const value) -> std::uint64_t {
+    return static_cast<std::uint64_t>(value) << 1 ^
+           static_cast<std::uint64_t>(value >> 63);
+}
+
+static auto unzigzag(std::uint64_t const value) -> std::int64_t {
+    return static_cast<std::int64_t>(value >> 1 ^ -(value & 1));
+}
+
+static auto chunk_at(std::span<char const> const bytes)
+    -> std::optional<ChunkHeader> {
+    if (bytes.size() < sizeof(ChunkHeader))
+        return std::nullopt;
+
+    ChunkHeader chunk;
+    std::memcpy(&chunk, bytes.data(), sizeof(ChunkHeader));
+
+    if (chunk.size > bytes.size() - sizeof(ChunkHeader))
+        return std::nullopt;
+
+    return chunk;
+}
+
+auto encode_scored_game(ScoredGame const &game, std::string &bytes) -> bool {
+    if (game.opening > game.moves.size() ||
+        game.scores.size() != game.moves.size() - game.opening ||
+        game.result > 2 || !load_fen(k_start_fen))
+        return false;
+
+    std::string encoded;
+
+    write_varint(encoded, game.moves.size());
+    write_varint(encoded, game.opening);
+    encoded += static_cast<char>(game.result);
+
+    for (PackedMove const packed : game.moves) {
+        std::vector<Move> const moves = legal_moves();
+        auto const found = std::ranges::find(moves, packed.decode());
+
+        if (found == moves.end())
+            return false;
+
+        encoded += static_cast<char>(found - moves.begin());
+
+        play(*found);
+    }
+
+    Score previous = 0;
+
+    for (Score const score : game.scores) {
+        write_varint(encoded, zigzag(std::int64_t{score} + previous));
+
+        previous = score;
+    }
+
+    bytes += encoded;
+
+    return true;
+}
+
+auto decode_scored_games(
+    std::span<char const> const bytes, std::uint32_t const count
+) -> std::optional<std::vector<ScoredGame>> {
+    Cursor cursor{bytes};
+    std::vector<ScoredGame> games(count);
+
+    for (ScoredGame &game : games) {
+        std::optional<std::uint64_t> const plies = cursor.varint();
+        std::optional<std::uint64_t> const opening =
+            plies ? cursor.varint() : std::nullopt;
+        std::optional<std::string_view> const result =
+            opening ? cursor.take(1) : std::nullopt;
+        std::optional<std::string_view> const indices =
+            result ? cursor.take(*plies) : std::nullopt;
+
+        if (!indices || *opening > *plies ||
+            static_cast<std::uint8_t>(result->front()) > 2 ||
+            !load_fen(k_start_fen))
+            return std::nullopt;
+
+        game.opening = static_cast<std::uint32_t>(*opening);
+        game.result = static_cast<std::uint8_t>(result->front());
+        game.moves.reserve(*plies);
+
+        for (char const index : *indices) {
+            std::vector<Move> const moves = legal_moves();
+            auto const position = static_cast<std::uint8_t>(index);
+
+            if (position >= moves.size())
+                return std::nullopt;
+
+            game.moves.push_back(PackedMove::encode(moves[position]));
+
+            play(moves[position]);
+        }
+
+        game.scores.reserve(*plies - *opening);
+
+        Score previous = 0;
+
+        for (std::uint64_t ply = *opening; ply < *plies; ++ply) {
+            std::optional<std::uint64_t> const delta = cursor.varint();
+
+            if (!delta)
+                return std::nullopt;
+
+            previous = static_cast<Score>(unzigzag(*delta) - previous);
+
+            game.scores.push_back(previous);
+        }
+    }
+
+    if (cursor.position != bytes.size())
+        return std::nullopt;
+
+    return games;
+}
+
+StreamWriter::~StreamWriter() { close(this->fd); }
+
+auto StreamWriter::open(char const *path) -> StreamWriter * {
+    std::int32_t const fd = ::open(path, O_RDWR | O_CREAT, 0644);
+
+    if (fd < 0)
+        return nullptr;
+
+    struct stat status{};
+
+    if (fstat(fd, &status) != 0) {
+        close(fd);
+
+        return nullptr;
+    }
+
+    auto const length = static_cast<std::uint64_t>(status.st_size);
+
+    Header header;
+    std::uint64_t end = sizeof(Header);
+
+    if (!length) {
+        if (pwrite(fd, &header, sizeof(Header), 0) !=
+            static_cast<ssize_t>(sizeof(Header))) {
+            close(fd);
+
+            return nullptr;
+        }
+    } else if (pread(fd, &header, sizeof(Header), 0) !=
+                   static_cast<ssize_t>(sizeof(Header)) ||
+               header.magic != k_magic || header.version != k_version) {
+        close(fd);
+
+        return nullptr;
+    }
+
+    ChunkHeader chunk;
+
+    while (end + sizeof(ChunkHeader) <= length &&
+           pread(fd, &chunk, sizeof(ChunkHeader), static_cast<off_t>(end)) ==
+               static_cast<ssize_t>(sizeof(ChunkHeader)) &&
+           chunk.size <= length - end - sizeof(ChunkHeader))
+        end += sizeof(ChunkHeader) + chunk.size;
+
+    auto *writer = new StreamWriter;
+
+    writer->fd = fd;
+    writer->end = end;
+
+    return writer;
+}
+
+auto StreamWriter::append(std::string const &bytes, std::uint32_t const games)
+    -> bool {
+    ChunkHeader const chunk{
+        .size = static_cast<std::uint32_t>(bytes.size()),
+        .games = games,
+    };
+
+    std::string block(sizeof(ChunkHeader), '\0');
+
+    std::memcpy(block.data(), &chunk, sizeof(ChunkHeader));
+    block += bytes;
+
+    std::uint64_t const offset =
+        this->end.fetch_add(block.size(), std::memory_order::relaxed);
+
+    return pwrite(
+               this->fd, block.data(), block.size(), static_cast<off_t>(offset)
+           ) == static_cast<ssize_t>(block.size());
+}
+
+StreamReader::~StreamReader() { munmap(this->mapping, this->length); }
+
+auto StreamReader::open(char const *path) -> StreamReader * {
+    std::int32_t const fd = ::open(path, O_RDONLY);
+
+    if (fd < 0)
+        return nullptr;
+
+    struct stat status{};
+
+    if (fstat(fd, &status) != 0 ||
+        static_cast<std::size_t>(status.st_size) < sizeof(Header)) {
+        close(fd);
+
+        return nullptr;
+    }
+
+    auto const length = static_cast<std::size_t>(status.st_size);
+
+    void *mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+        return nullptr;
+
+    std::span<char const> bytes(static_cast<char const *>(mapping), length);
+
+    Header header;
+    std::memcpy(&header, bytes.data(), sizeof(Header));
+
+    if (header.magic != k_magic || header.version != k_version) {
+        munmap(mapping, length);
+
+        return nullptr;
+    }
+
+    madvise(mapping, length, MADV_SEQUENTIAL);
+
+    auto *reader = new StreamReader;
+
+    reader->mapping = mapping;
+    reader->length = length;
+
+    bytes = bytes.subspan(sizeof(Header));
+
+    while (std::optional<ChunkHeader> const chunk = chunk_at(bytes)) {
+        reader->chunks.push_back({
+            .bytes = bytes.subspan(sizeof(ChunkHeader), chunk->size),
+            .games = chunk->games,
+        });
+
+        bytes = bytes.subspan(sizeof(ChunkHeader) + chunk->size);
+    }
+
+    return reader;
+}
+
+auto StreamReader::size() const -> std::size_t { return this->chunks.size(); }
+
+auto StreamReader::games(std::size_t const chunk) const
+    -> std::optional<std::vector<ScoredGame>> {
+    if (chunk >= this->chunks.size())
+        return std::nullopt;
+
+    return decode_scored_games(
+        this->chunks[chunk].bytes, this->chunks[chunk].games
+    );
+}
@@ -0,0 +1,77 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include "../eval/tables.h"
+#include "../move/move.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+struct ScoredGame final {
+    std::vector<PackedMove> moves;
+    std::vector<Score> scores;
+    std::uint32_t opening = 0;
+    std::uint8_t result = 1;
+};
+
+[[nodiscard]] auto encode_scored_game(
+    ScoredGame const &game, std::string &bytes
+) -> bool;
+
+[[nodiscard]] auto decode_scored_games(
+    std::span<char const> bytes, std::uint32_t count
+) -> std::optional<std::vector<ScoredGame>>;
+
+class StreamWriter final {
+  public:
+    StreamWriter(StreamWriter const &) = delete;
+
+    auto operator=(StreamWriter const &) -> StreamWriter & = delete;
+
+    ~StreamWriter();
+
+    [[nodiscard]] static auto open(char const *path) -> StreamWriter *;
+
+    auto append(std::string const &bytes, std::uint32_t games) -> bool;
+
+  private:
+    std::int32_t fd = -1;
+    std::atomic<std::uint64_t> end = 0;
+
+    StreamWriter() = default;
+};
+
+class StreamReader final {
+  public:
+    StreamReader(StreamReader const &) = delete;
+
+    auto operator=(StreamReader const &) -> StreamReader & = delete;
+
+    ~StreamReader();
+
+    [[nodiscard]] static auto open(char const *path) -> StreamReader *;
+
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    [[nodiscard]] auto games(std::size_t chunk) const
+        -> std::optional<std::vector<ScoredGame>>;
+
+  private:
+    struct Chunk final {
+        std::span<char const> bytes;
+        std::uint32_t games = 0;
+    };
+
+    void *mapping = nullptr;
+    std::size_t length = 0;
+    std::vector<Chunk> chunks;
+
+    StreamReader() = default;
+};
+
+#endif // STREAM_H
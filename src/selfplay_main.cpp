@@ -0,0 +1,87 @@
+#include "selfplay/selfplay.h"
+#include "selfplay/stream.h"
+
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+
+static void print_summary(SelfPlaySummary const &summary) {
+    double const seconds =
+        std::chrono::duration<double>(summary.elapsed).count();
+
+    std::cerr << std::format(
+        "{} games, {} positions, {:.2f} bytes/position, {:.0f} positions/s\n",
+        summary.games, summary.positions,
+        summary.positions ? static_cast<double>(summary.bytes) /
+                                static_cast<double>(summary.positions)
+                          : 0.0,
+        seconds > 0 ? static_cast<double>(summary.positions) / seconds : 0.0
+    );
+}
+
+std::int32_t main(std::int32_t argc, char *argv[]) {
+    SelfPlayOptions options{
+        .threads =
+            static_cast<std::int32_t>(std::thread::hardware_concurrency()),
+    };
+    char const *path = nullptr;
+
+    for (std::int32_t i = 1; i < argc; ++i) {
+        std::string_view const argument = argv[i];
+
+        if (argument == "--games" && i + 1 < argc) {
+            options.games = std::stoull(argv[++i]);
+        } else if (argument == "--nodes" && i + 1 < argc) {
+            options.nodes = std::stoull(argv[++i]);
+        } else if (argument == "--threads" && i + 1 < argc) {
+            options.threads = std::stoi(argv[++i]);
+        } else if (argument == "--random" && i + 1 < argc) {
+            options.random_plies = std::stoi(argv[++i]);
+        } else if (argument == "--max-plies" && i + 1 < argc) {
+            options.max_plies = std::stoi(argv[++i]);
+        } else if (argument == "--hash" && i + 1 < argc) {
+            options.hash = std::stoull(argv[++i]);
+        } else if (argument == "--seed" && i + 1 < argc) {
+            options.seed = std::stoull(argv[++i]);
+        } else if (argument.starts_with("--") || path) {
+            std::cerr << std::format("unknown option {}\n", argument);
+
+            return 1;
+        } else {
+            path = argv[i];
+        }
+    }
+
+    if (!path) {
+        std::cerr << "usage: chess-selfplay [--games n] [--nodes n] "
+                     "[--threads n] [--random n] [--max-plies n] [--hash mb] "
+                     "[--seed n] output\n";
+
+        return 1;
+    }
+
+    std::unique_ptr<StreamWriter> const writer(StreamWriter::open(path));
+
+    if (!writer) {
+        std::cerr << std::format("cannot open {}\n", path);
+
+        return 1;
+    }
+
+    SelfPlaySummary const summary =
+        generate_games(options, *writer, print_summary);
+
+    print_summary(summary);
+
+    if (summary.failed) {
+        std::cerr << std::format("failed to write {}\n", path);
+
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,201 @@
+#include "loadgen.h"
+
+#include "protocol.h"
+
+#include <algorithm>
+#include <format>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+static std::string_view constexpr k_time_control = "300000 2000";
+
+class Client final {
+  public:
+    explicit Client(std::int32_t const fd) : fd(fd) {}
+
+    Client(Client const &) = delete;
+
+    auto operator=(Client const &) -> Client & = delete;
+
+    ~Client() { close(this->fd); }
+
+    [[nodiscard]] auto request(std::string_view const payload)
+        -> std::optional<std::string> {
+        auto const start = std::chrono::steady_clock::now();
+
+        std::optional<std::string> const reply =
+            send_frame(this->fd, payload)
+                ? receive_frame(this->fd, this->buffer)
+                : std::nullopt;
+
+        this->latencies.push_back(std::chrono::steady_clock::now() - start);
+
+        if (reply && reply->starts_with("error"))
+            ++this->errors;
+
+        return reply;
+    }
+
+    [[nodiscard]] auto start_game() -> std::optional<std::uint64_t> {
+        std::optional<std::string> const reply =
+            this->request(std::format("new {}", k_time_control));
+
+        if (!reply || !reply->starts_with("ok "))
+            return std::nullopt;
+
+        ++this->games;
+
+        return std::stoull(reply->substr(3));
+    }
+
+    std::vector<std::chrono::nanoseconds> latencies;
+    std::uint64_t errors = 0;
+    std::uint64_t games = 0;
+
+  private:
+    std::int32_t fd;
+    std::string buffer;
+};
+
+static auto split(std::string_view const text) -> std::vector<std::string> {
+    std::vector<std::string> words;
+
+    for (auto const &word : text | std::views::split(' '))
+        if (!word.empty())
+            words.emplace_back(word.begin(), word.end());
+
+    return words;
+}
+
+static auto play(
+    Client &client, LoadOptions const &options, std::mt19937_64 &random
+) -> bool {
+    std::vector<std::uint64_t> sessions;
+
+    for (std::int32_t i = 0; i < std::max(options.sessions, 1); ++i)
+        if (std::optional<std::uint64_t> const id = client.start_game())
+            sessions.push_back(*id);
+        else
+            return false;
+
+    std::uint64_t moves = 0;
+
+    for (std::uint64_t i = 0; client.latencies.size() < options.requests;
+         ++i) {
+        std::uint64_t &session = sessions[i % sessions.size()];
+
+        std::optional<std::string> const legal =
+            client.request(std::format("legal {}", session));
+
+        if (!legal)
+            return false;
+
+        std::vector<std::string> const words = split(*legal);
+
+        if (words.size() < 2) {
+            std::optional<std::string> const closed =
+                client.request(std::format("close {}", session));
+            std::optional<std::uint64_t> const id =
+                closed ? client.start_game() : std::nullopt;
+
+            if (!id)
+                return false;
+
+            session = *id;
+
+            continue;
+        }
+
+        bool const engine =
+            options.engine_every > 0 &&
+            ++moves % static_cast<std::uint64_t>(options.engine_every) == 0;
+        std::string const &move =
+            words[std::uniform_int_distribution<std::size_t>(
+                1, words.size() - 1
+            )(random)];
+        std::string const request =
+            engine ? std::format("go {} {}", session, options.nodes)
+                   : std::format("move {} {}", session, move);
+
+        if (!client.request(request))
+            return false;
+    }
+
+    return true;
+}
+
+static auto percentile(
+    std::vector<std::chrono::nanoseconds> const &sorted, double const fraction
+) -> std::chrono::nanoseconds {
+    if (sorted.empty())
+        return {};
+
+    return sorted[std::min(
+        sorted.size() - 1,
+        static_cast<std::size_t>(fraction * static_cast<double>(sorted.size()))
+    )];
+}
+
+auto generate_load(LoadOptions const &options) -> LoadSummary {
+    auto const start = std::chrono::steady_clock::now();
+
+    LoadSummary summary;
+    std::vector<std::chrono::nanoseconds> latencies;
+    std::mutex mutex;
+
+    std::vector<std::thread> clients;
+
+    for (std::int32_t i = 0; i < std::max(options.clients, 1); ++i)
+        clients.emplace_back([&options, &summary, &latencies, &mutex,
+                              i]() -> void {
+            std::int32_t const fd = connect_to(options.endpoint);
+
+            if (fd < 0) {
+                std::lock_guard const lock(mutex);
+
+                summary.failed = true;
+
+                return;
+            }
+
+            Client client(fd);
+            std::mt19937_64 random(
+                options.seed + static_cast<std::uint64_t>(i)
+            );
+
+            bool const played = play(client, options, random);
+
+            std::lock_guard const lock(mutex);
+
+            summary.requests += client.latencies.size();
+            summary.errors += client.errors;
+            summary.games += client.games;
+            summary.failed = summary.failed || !played;
+
+            latencies.insert(
+                latencies.end(), client.latencies.begin(),
+                client.latencies.end()
+            );
+        });
+
+    for (std::thread &client : clients)
+        client.join();
+
+    summary.elapsed = std::chrono::steady_clock::now() - start;
+
+    std::ranges::sort(latencies);
+
+    summary.p50 = percentile(latencies, 0.5);
+    summary.p99 = percentile(latencies, 0.99);
+    summary.max = latencies.empty() ? std::chrono::nanoseconds{}
+                                    : latencies.back();
+
+    return summary;
+}
@@ -0,0 +1,31 @@
+#ifndef LOADGEN_H
+#define LOADGEN_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+struct LoadOptions final {
+    std::string endpoint = "/tmp/chess.sock";
+    std::int32_t clients = 8;
+    std::int32_t sessions = 16;
+    std::uint64_t requests = 10000;
+    std::int32_t engine_every = 0;
+    std::uint64_t nodes = 1000;
+    std::uint64_t seed = 0;
+};
+
+struct LoadSummary final {
+    std::uint64_t requests = 0;
+    std::uint64_t errors = 0;
+    std::uint64_t games = 0;
+    std::chrono::nanoseconds elapsed{};
+    std::chrono::nanoseconds p50{};
+    std::chrono::nanoseconds p99{};
+    std::chrono::nanoseconds max{};
+    bool failed = false;
+};
+
+[[nodiscard]] auto generate_load(LoadOptions const &options) -> LoadSummary;
+
+#endif // LOADGEN_H
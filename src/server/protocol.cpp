@@ -0,0 +1,197 @@
+#include "protocol.h"
+
+#include <array>
+#include <cstring>
+#include <string>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static std::size_t constexpr k_read_size = 1 << 16;
+
+struct Address final {
+    sockaddr_storage storage{};
+    socklen_t length = 0;
+};
+
+static auto resolve(std::string_view const endpoint) -> std::optional<Address> {
+    Address address;
+
+    if (endpoint.find('/') != std::string_view::npos) {
+        auto *unix_address = reinterpret_cast<sockaddr_un *>(&address.storage);
+
+        if (endpoint.size() >= sizeof(unix_address->sun_path))
+            return std::nullopt;
+
+        unix_address->sun_family = AF_UNIX;
+        std::memcpy(unix_address->sun_path, endpoint.data(), endpoint.size());
+
+        address.length = sizeof(sockaddr_un);
+
+        return address;
+    }
+
+    std::size_t const colon = endpoint.rfind(':');
+    std::string const host(
+        colon == std::string_view::npos ? "127.0.0.1"
+                                        : endpoint.substr(0, colon)
+    );
+    std::string const port(
+        colon == std::string_view::npos ? endpoint : endpoint.substr(colon + 1)
+    );
+
+    auto *inet_address = reinterpret_cast<sockaddr_in *>(&address.storage);
+
+    inet_address->sin_family = AF_INET;
+
+    try {
+        inet_address->sin_port =
+            htons(static_cast<std::uint16_t>(std::stoi(port)));
+    } catch (std::exception const &) {
+        return std::nullopt;
+    }
+
+    if (inet_pton(AF_INET, host.c_str(), &inet_address->sin_addr) != 1)
+        return std::nullopt;
+
+    address.length = sizeof(sockaddr_in);
+
+    return address;
+}
+
+auto encode_frame(std::string_view const payload) -> std::string {
+    auto const length = static_cast<std::uint32_t>(payload.size());
+
+    std::string frame(k_frame_header, '\0');
+
+    for (std::size_t i = 0; i < k_frame_header; ++i)
+        frame[i] = static_cast<char>(length >> (i * 8) & 255);
+
+    frame += payload;
+
+    return frame;
+}
+
+auto frame_length(std::string_view const buffer)
+    -> std::optional<std::size_t> {
+    if (buffer.size() < k_frame_header)
+        return std::nullopt;
+
+    std::size_t length = 0;
+
+    for (std::size_t i = 0; i < k_frame_header; ++i)
+        length |= std::size_t{static_cast<std::uint8_t>(buffer[i])} << (i * 8);
+
+    return length;
+}
+
+auto listen_on(std::string_view const endpoint) -> std::int32_t {
+    std::optional<Address> const address = resolve(endpoint);
+
+    if (!address)
+        return -1;
+
+    std::int32_t const fd = socket(
+        address->storage.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+        0
+    );
+
+    if (fd < 0)
+        return -1;
+
+    std::int32_t const enable = 1;
+
+    if (address->storage.ss_family == AF_UNIX)
+        unlink(std::string(endpoint).c_str());
+    else
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    if (bind(
+            fd, reinterpret_cast<sockaddr const *>(&address->storage),
+            address->length
+        ) != 0 ||
+        listen(fd, SOMAXCONN) != 0) {
+        close(fd);
+
+        return -1;
+    }
+
+    return fd;
+}
+
+auto connect_to(std::string_view const endpoint) -> std::int32_t {
+    std::optional<Address> const address = resolve(endpoint);
+
+    if (!address)
+        return -1;
+
+    std::int32_t const fd =
+        socket(address->storage.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (fd < 0)
+        return -1;
+
+    if (connect(
+            fd, reinterpret_cast<sockaddr const *>(&address->storage),
+            address->length
+        ) != 0) {
+        close(fd);
+
+        return -1;
+    }
+
+    std::int32_t const enable = 1;
+
+    if (address->storage.ss_family == AF_INET)
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+    return fd;
+}
+
+auto send_frame(std::int32_t const fd, std::string_view const payload)
+    -> bool {
+    std::string const frame = encode_frame(payload);
+
+    for (std::size_t sent = 0; sent < frame.size();) {
+        ssize_t const written =
+            send(fd, frame.data() + sent, frame.size() - sent, MSG_NOSIGNAL);
+
+        if (written <= 0)
+            return false;
+
+        sent += static_cast<std::size_t>(written);
+    }
+
+    return true;
+}
+
+auto receive_frame(std::int32_t const fd, std::string &buffer)
+    -> std::optional<std::string> {
+    std::array<char, k_read_size> chunk;
+
+    while (true) {
+        std::optional<std::size_t> const length = frame_length(buffer);
+
+        if (length && *length > k_max_frame)
+            return std::nullopt;
+
+        if (length && buffer.size() >= k_frame_header + *length) {
+            std::string payload = buffer.substr(k_frame_header, *length);
+
+            buffer.erase(0, k_frame_header + *length);
+
+            return payload;
+        }
+
+        ssize_t const count = recv(fd, chunk.data(), chunk.size(), 0);
+
+        if (count <= 0)
+            return std::nullopt;
+
+        buffer.append(chunk.data(), static_cast<std::size_t>(count));
+    }
+}
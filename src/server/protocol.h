@@ -0,0 +1,28 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+inline static std::size_t constexpr k_frame_header = 4;
+inline static std::size_t constexpr k_max_frame = std::size_t{1} << 20;
+
+[[nodiscard]] auto encode_frame(std::string_view payload) -> std::string;
+
+[[nodiscard]] auto frame_length(std::string_view buffer)
+    -> std::optional<std::size_t>;
+
+[[nodiscard]] auto listen_on(std::string_view endpoint) -> std::int32_t;
+
+[[nodiscard]] auto connect_to(std::string_view endpoint) -> std::int32_t;
+
+[[nodiscard]] auto send_frame(std::int32_t fd, std::string_view payload)
+    -> bool;
+
+[[nodiscard]] auto receive_frame(std::int32_t fd, std::string &buffer)
+    -> std::optional<std::string>;
+
+#endif // PROTOCOL_H
@@ -0,0 +1,339 @@
+#include "server.h"
+
+#include "../board/board.h"
+#include "protocol.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static auto watch(
+    std::int32_t const epoll, std::int32_t const operation,
+    std::int32_t const fd, std::uint32_t const events, std::uint64_t const id
+) -> bool {
+    epoll_event event{.events = events, .data = {.u64 = id}};
+
+    return epoll_ctl(epoll, operation, fd, &event) == 0;
+}
+
+Server::Server(ServerOptions const &options)
+    : options(options), sessions(options.max_nodes, options.max_time) {
+    this->options.workers = std::max(this->options.workers, 1);
+}
+
+Server::~Server() {
+    for (std::int32_t const fd : {this->listener, this->epoll, this->wakeup})
+        if (fd >= 0)
+            close(fd);
+}
+
+auto Server::run() -> bool {
+    this->listener = listen_on(this->options.endpoint);
+    this->epoll = epoll_create1(EPOLL_CLOEXEC);
+    this->wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (this->listener < 0 || this->epoll < 0 || this->wakeup < 0)
+        return false;
+
+    if (!watch(
+            this->epoll, EPOLL_CTL_ADD, this->listener, EPOLLIN, k_listener
+        ) ||
+        !watch(this->epoll, EPOLL_CTL_ADD, this->wakeup, EPOLLIN, k_wakeup))
+        return false;
+
+    for (std::int32_t i = 0; i < this->options.workers; ++i)
+        this->workers.emplace_back([this]() -> void { this->work(); });
+
+    std::array<epoll_event, k_max_events> events;
+
+    while (!this->stopping) {
+        std::int32_t const count =
+            epoll_wait(this->epoll, events.data(), k_max_events, -1);
+
+        if (count < 0 && errno != EINTR)
+            break;
+
+        for (std::int32_t i = 0; i < count; ++i) {
+            std::uint64_t const id = events[i].data.u64;
+            std::uint32_t const flags = events[i].events;
+
+            if (id == k_listener) {
+                this->accept();
+            } else if (id == k_wakeup) {
+                this->deliver();
+            } else if (flags & (EPOLLERR | EPOLLHUP)) {
+                this->disconnect(id);
+            } else {
+                if (flags & EPOLLOUT) {
+                    auto const found = this->connections.find(id);
+
+                    if (found != this->connections.end() &&
+                        !this->flush(id, found->second))
+                        continue;
+                }
+
+                if (flags & (EPOLLIN | EPOLLRDHUP))
+                    this->receive(id);
+            }
+        }
+    }
+
+    {
+        std::lock_guard const lock(this->mutex);
+
+        this->stopping = true;
+        this->signals.stop = true;
+    }
+
+    this->available.notify_all();
+
+    for (std::thread &worker : this->workers)
+        worker.join();
+
+    this->workers.clear();
+
+    while (!this->connections.empty())
+        this->disconnect(this->connections.begin()->first);
+
+    if (this->options.endpoint.find('/') != std::string::npos)
+        unlink(this->options.endpoint.c_str());
+
+    return true;
+}
+
+void Server::stop() {
+    this->stopping = true;
+    this->signals.stop = true;
+
+    std::uint64_t const one = 1;
+
+    (void)write(this->wakeup, &one, sizeof(one));
+}
+
+auto Server::size() const -> std::size_t { return this->sessions.size(); }
+
+void Server::work() {
+    TranspositionTable table(this->options.hash);
+
+    while (true) {
+        Job job;
+
+        {
+            std::unique_lock lock(this->mutex);
+
+            this->available.wait(lock, [this]() -> bool {
+                return this->stopping || !this->jobs.empty();
+            });
+
+            if (this->jobs.empty())
+                break;
+
+            job = std::move(this->jobs.front());
+            this->jobs.pop_front();
+        }
+
+        job.payload = this->sessions.handle(
+            job.connection, job.payload, table, this->signals
+        );
+
+        {
+            std::lock_guard const lock(this->replies_mutex);
+
+            this->replies.push_back(std::move(job));
+        }
+
+        std::uint64_t const one = 1;
+
+        (void)write(this->wakeup, &one, sizeof(one));
+    }
+
+    clear_board();
+}
+
+void Server::accept() {
+    while (true) {
+        std::int32_t const fd = accept4(
+            this->listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC
+        );
+
+        if (fd < 0)
+            return;
+
+        std::int32_t const enable = 1;
+
+        (void)setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        std::uint64_t const id = this->next++;
+
+        if (!watch(this->epoll, EPOLL_CTL_ADD, fd, EPOLLIN | EPOLLRDHUP, id)) {
+            close(fd);
+
+            continue;
+        }
+
+        this->connections.emplace(id, Connection{.fd = fd});
+    }
+}
+
+void Server::receive(std::uint64_t const id) {
+    auto const found = this->connections.find(id);
+
+    if (found == this->connections.end())
+        return;
+
+    Connection &connection = found->second;
+    std::array<char, k_read_size> buffer;
+
+    while (true) {
+        ssize_t const count = read(connection.fd, buffer.data(), buffer.size());
+
+        if (count > 0) {
+            connection.input.append(
+                buffer.data(), static_cast<std::size_t>(count)
+            );
+
+            std::optional<std::size_t> const length =
+                frame_length(connection.input);
+
+            if ((length && *length > k_max_frame) ||
+                connection.input.size() > k_frame_header + k_max_frame) {
+                this->disconnect(id);
+
+                return;
+            }
+
+            continue;
+        }
+
+        if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+
+        if (count < 0 && errno == EINTR)
+            continue;
+
+        this->disconnect(id);
+
+        return;
+    }
+
+    this->dispatch(id, connection);
+}
+
+void Server::deliver() {
+    std::uint64_t count = 0;
+
+    (void)read(this->wakeup, &count, sizeof(count));
+
+    std::vector<Job> ready;
+
+    {
+        std::lock_guard const lock(this->replies_mutex);
+
+        ready.swap(this->replies);
+    }
+
+    for (Job const &reply : ready) {
+        auto const found = this->connections.find(reply.connection);
+
+        if (found == this->connections.end()) {
+            this->sessions.drop(reply.connection);
+
+            continue;
+        }
+
+        Connection &connection = found->second;
+
+        connection.busy = false;
+        connection.output += encode_frame(reply.payload);
+
+        if (this->flush(reply.connection, connection))
+            this->dispatch(reply.connection, connection);
+    }
+}
+
+void Server::dispatch(std::uint64_t const id, Connection &connection) {
+    if (connection.busy)
+        return;
+
+    std::optional<std::size_t> const length = frame_length(connection.input);
+
+    if (!length || connection.input.size() < k_frame_header + *length)
+        return;
+
+    Job job{
+        .connection = id,
+        .payload = connection.input.substr(k_frame_header, *length),
+    };
+
+    connection.input.erase(0, k_frame_header + *length);
+    connection.busy = true;
+
+    {
+        std::lock_guard const lock(this->mutex);
+
+        this->jobs.push_back(std::move(job));
+    }
+
+    this->available.notify_one();
+}
+
+auto Server::flush(std::uint64_t const id, Connection &connection) -> bool {
+    std::size_t sent = 0;
+
+    while (sent < connection.output.size()) {
+        ssize_t const written = send(
+            connection.fd, connection.output.data() + sent,
+            connection.output.size() - sent, MSG_NOSIGNAL
+        );
+
+        if (written > 0) {
+            sent += static_cast<std::size_t>(written);
+
+            continue;
+        }
+
+        if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+
+        if (written < 0 && errno == EINTR)
+            continue;
+
+        this->disconnect(id);
+
+        return false;
+    }
+
+    connection.output.erase(0, sent);
+
+    bool const writing = !connection.output.empty();
+
+    if (writing != connection.writing) {
+        connection.writing = writing;
+
+        (void)watch(
+            this->epoll, EPOLL_CTL_MOD, connection.fd,
+            EPOLLIN | EPOLLRDHUP | (writing ? EPOLLOUT : 0u), id
+        );
+    }
+
+    return true;
+}
+
+void Server::disconnect(std::uint64_t const id) {
+    auto const found = this->connections.find(id);
+
+    if (found == this->connections.end())
+        return;
+
+    close(found->second.fd);
+
+    this->connections.erase(found);
+    this->sessions.drop(id);
+}
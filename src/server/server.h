@@ -0,0 +1,93 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "session.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct ServerOptions final {
+    std::string endpoint = "/tmp/chess.sock";
+    std::int32_t workers = 1;
+    std::size_t hash = 4;
+    std::uint64_t max_nodes = 1000000;
+    std::chrono::milliseconds max_time{1000};
+};
+
+class Server final {
+  public:
+    explicit Server(ServerOptions const &options);
+
+    ~Server();
+
+    [[nodiscard]] auto run() -> bool;
+
+    void stop();
+
+    [[nodiscard]] auto size() const -> std::size_t;
+
+  private:
+    inline static std::uint64_t constexpr k_listener = 0;
+    inline static std::uint64_t constexpr k_wakeup = 1;
+    inline static std::int32_t constexpr k_max_events = 256;
+    inline static std::size_t constexpr k_read_size = 1 << 16;
+
+    struct Connection final {
+        std::int32_t fd = -1;
+        std::string input{};
+        std::string output{};
+        bool busy = false;
+        bool writing = false;
+    };
+
+    struct Job final {
+        std::uint64_t connection;
+        std::string payload;
+    };
+
+    ServerOptions options;
+    Sessions sessions;
+
+    std::int32_t listener = -1;
+    std::int32_t epoll = -1;
+    std::int32_t wakeup = -1;
+    std::atomic<bool> stopping = false;
+    Signals signals;
+
+    std::unordered_map<std::uint64_t, Connection> connections;
+    std::uint64_t next = k_wakeup + 1;
+
+    std::mutex mutex;
+    std::condition_variable available;
+    std::deque<Job> jobs;
+
+    std::mutex replies_mutex;
+    std::vector<Job> replies;
+
+    std::vector<std::thread> workers;
+
+    void work();
+
+    void accept();
+
+    void receive(std::uint64_t id);
+
+    void deliver();
+
+    void dispatch(std::uint64_t id, Connection &connection);
+
+    auto flush(std::uint64_t id, Connection &connection) -> bool;
+
+    void disconnect(std::uint64_t id);
+};
+
+#endif // SERVER_H
@@ -0,0 +1,256 @@
+#include "session.h"
+
+#include "../board/board.h"
+#include "../search/search.h"
+#include "../vars.h"
+
+#include <algorithm>
+#include <format>
+#include <optional>
+
+using namespace std::chrono_literals;
+
+static std::uint64_t constexpr k_default_nodes = 10000;
+
+static auto game_status() -> std::string {
+    if (!has_legal_moves())
+        return in_check() ? "checkmate" : "stalemate";
+
+    return is_draw() ? "draw" : "ongoing";
+}
+
+static auto remaining(Session const &session, Session::Clock::time_point now)
+    -> std::array<std::chrono::milliseconds, 2> {
+    std::array<std::chrono::milliseconds, 2> clocks = session.clocks;
+
+    if (session.timed && session.status == "ongoing") {
+        auto const side = static_cast<std::size_t>(k_current_player);
+
+        clocks[side] -=
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                now - session.turn
+            );
+        clocks[side] = std::max(clocks[side], 0ms);
+    }
+
+    return clocks;
+}
+
+static auto play_move(Session &session, Move const &move) -> std::string {
+    auto const now = Session::Clock::now();
+    auto const side = static_cast<std::size_t>(k_current_player);
+
+    if (session.timed) {
+        std::array<std::chrono::milliseconds, 2> const clocks =
+            remaining(session, now);
+
+        session.clocks[side] = clocks[side];
+
+        if (clocks[side] <= 0ms) {
+            session.status = "flagged";
+
+            return "error game over: flagged";
+        }
+
+        session.clocks[side] += session.increment;
+        session.turn = now;
+    }
+
+    session.moves.push_back(to_uci(move));
+
+    play(move);
+
+    session.fen = fen();
+    session.history = k_history;
+    session.status = game_status();
+
+    return std::format("ok {}", session.status);
+}
+
+Sessions::Sessions(
+    std::uint64_t const max_nodes, std::chrono::milliseconds const max_time
+)
+    : max_nodes(max_nodes), max_time(max_time) {}
+
+auto Sessions::handle(
+    std::uint64_t const owner, std::string_view const request,
+    TranspositionTable &table, Signals &signals
+) -> std::string {
+    std::istringstream arguments{std::string(request)};
+    std::string command;
+
+    arguments >> command;
+
+    if (command == "new")
+        return this->create(owner, arguments);
+
+    if (command == "close")
+        return this->close(owner, arguments);
+
+    std::shared_ptr<Session> const session = this->find(owner, arguments);
+
+    if (!session)
+        return "error unknown session";
+
+    std::lock_guard const lock(session->mutex);
+
+    (void)load_fen(session->fen);
+
+    k_history = session->history;
+
+    if (command == "fen")
+        return std::format("ok {}", session->fen);
+
+    if (command == "moves") {
+        std::string reply = "ok";
+
+        for (std::string const &move : session->moves)
+            reply += ' ' + move;
+
+        return reply;
+    }
+
+    if (command == "clock") {
+        std::array<std::chrono::milliseconds, 2> const clocks =
+            remaining(*session, Session::Clock::now());
+
+        return std::format("ok {} {}", clocks[0].count(), clocks[1].count());
+    }
+
+    if (command == "legal") {
+        std::string reply = "ok";
+
+        if (session->status == "ongoing")
+            for (Move const &move : legal_moves())
+                reply += ' ' + to_uci(move);
+
+        return reply;
+    }
+
+    if (session->status != "ongoing")
+        return std::format("error game over: {}", session->status);
+
+    if (command == "move") {
+        std::string text;
+        arguments >> text;
+
+        std::optional<Move> const move = parse_uci(text);
+
+        if (!move)
+            return "error illegal move";
+
+        return play_move(*session, *move);
+    }
+
+    if (command == "go") {
+        std::uint64_t nodes = k_default_nodes;
+
+        if (!(arguments >> nodes))
+            nodes = k_default_nodes;
+
+        Searcher searcher(table, signals);
+
+        Result const found = searcher.search({
+            .nodes = std::min(nodes, this->max_nodes),
+            .cap = this->max_time,
+        });
+        std::string const move = to_uci(found.pv.front());
+        std::string const reply = play_move(*session, found.pv.front());
+
+        if (reply.starts_with("error"))
+            return reply;
+
+        return std::format("ok {} {} {}", move, found.score, session->status);
+    }
+
+    return std::format("error unknown command {}", command);
+}
+
+void Sessions::drop(std::uint64_t const owner) {
+    std::lock_guard const lock(this->mutex);
+
+    std::erase_if(this->sessions, [owner](auto const &entry) -> bool {
+        return entry.second->owner == owner;
+    });
+}
+
+auto Sessions::size() const -> std::size_t {
+    std::shared_lock const lock(this->mutex);
+
+    return this->sessions.size();
+}
+
+auto Sessions::find(
+    std::uint64_t const owner, std::istringstream &arguments
+) const -> std::shared_ptr<Session> {
+    std::uint64_t id = 0;
+
+    if (!(arguments >> id))
+        return nullptr;
+
+    std::shared_lock const lock(this->mutex);
+
+    auto const found = this->sessions.find(id);
+
+    if (found == this->sessions.end() || found->second->owner != owner)
+        return nullptr;
+
+    return found->second;
+}
+
+auto Sessions::create(
+    std::uint64_t const owner, std::istringstream &arguments
+) -> std::string {
+    std::int64_t base = 0;
+    std::int64_t increment = 0;
+
+    if (!(arguments >> base >> increment) || base < 0 || increment < 0)
+        return "error usage: new <base-ms> <increment-ms> [fen]";
+
+    std::string position;
+    std::getline(arguments >> std::ws, position);
+
+    if (!load_fen(position.empty() ? k_start_fen : position))
+        return "error invalid fen";
+
+    auto session = std::make_shared<Session>();
+
+    session->owner = owner;
+    session->fen = fen();
+    session->history = k_history;
+    session->timed = base > 0;
+    session->clocks = {
+        std::chrono::milliseconds(base), std::chrono::milliseconds(base)
+    };
+    session->increment = std::chrono::milliseconds(increment);
+    session->turn = Session::Clock::now();
+    session->status = game_status();
+
+    std::uint64_t const id = this->next++;
+
+    std::lock_guard const lock(this->mutex);
+
+    this->sessions.emplace(id, std::move(session));
+
+    return std::format("ok {}", id);
+}
+
+auto Sessions::close(
+    std::uint64_t const owner, std::istringstream &arguments
+) -> std::string {
+    std::uint64_t id = 0;
+
+    if (!(arguments >> id))
+        return "error unknown session";
+
+    std::lock_guard const lock(this->mutex);
+
+    auto const found = this->sessions.find(id);
+
+    if (found == this->sessions.end() || found->second->owner != owner)
+        return "error unknown session";
+
+    this->sessions.erase(found);
+
+    return "ok";
+}
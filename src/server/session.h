@@ -0,0 +1,71 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include "../board/zobrist.h"
+#include "../search/search.h"
+#include "../search/table.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct Session final {
+    using Clock = std::chrono::steady_clock;
+
+    std::mutex mutex;
+    std::uint64_t owner = 0;
+    std::string fen;
+    std::vector<Hash> history;
+    std::vector<std::string> moves;
+    bool timed = false;
+    std::array<std::chrono::milliseconds, 2> clocks{};
+    std::chrono::milliseconds increment{};
+    Clock::time_point turn{};
+    std::string status = "ongoing";
+};
+
+class Sessions final {
+  public:
+    Sessions(std::uint64_t max_nodes, std::chrono::milliseconds max_time);
+
+    [[nodiscard]] auto handle(
+        std::uint64_t owner, std::string_view request,
+        TranspositionTable &table, Signals &signals
+    ) -> std::string;
+
+    void drop(std::uint64_t owner);
+
+    [[nodiscard]] auto size() const -> std::size_t;
+
+  private:
+    std::uint64_t max_nodes;
+    std::chrono::milliseconds max_time;
+
+    mutable std::shared_mutex mutex;
+    std::unordered_map<std::uint64_t, std::shared_ptr<Session>> sessions;
+    std::atomic<std::uint64_t> next = 1;
+
+    [[nodiscard]] auto find(
+        std::uint64_t owner, std::istringstream &arguments
+    ) const -> std::shared_ptr<Session>;
+
+    [[nodiscard]] auto create(
+        std::uint64_t owner, std::istringstream &arguments
+    ) -> std::string;
+
+    [[nodiscard]] auto close(
+        std::uint64_t owner, std::istringstream &arguments
+    ) -> std::string;
+};
+
+#endif // SESSION_H
@@ -0,0 +1,79 @@
+#include "server/server.h"
+
+#include <charconv>
+#include <chrono>
+#include <csignal>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+static Server *k_server = nullptr;
+
+template <typename Number>
+static auto parse(std::string_view const text, Number &number) -> bool {
+    auto const [end, error] =
+        std::from_chars(text.data(), text.data() + text.size(), number);
+
+    return error == std::errc{} && end == text.data() + text.size();
+}
+
+std::int32_t main(std::int32_t argc, char *argv[]) {
+    std::signal(SIGPIPE, SIG_IGN);
+
+    ServerOptions options{
+        .workers =
+            static_cast<std::int32_t>(std::thread::hardware_concurrency()),
+    };
+
+    for (std::int32_t i = 1; i < argc; ++i) {
+        std::string_view const argument = argv[i];
+        std::int64_t milliseconds = 0;
+        bool parsed = i + 1 < argc;
+
+        if (argument == "--listen" && parsed) {
+            options.endpoint = argv[++i];
+        } else if (argument == "--workers" && parsed) {
+            parsed = parse(argv[++i], options.workers);
+        } else if (argument == "--hash" && parsed) {
+            parsed = parse(argv[++i], options.hash);
+        } else if (argument == "--max-nodes" && parsed) {
+            parsed = parse(argv[++i], options.max_nodes);
+        } else if (argument == "--max-time" && parsed) {
+            parsed = parse(argv[++i], milliseconds) && milliseconds >= 0;
+            options.max_time = std::chrono::milliseconds(milliseconds);
+        } else {
+            parsed = false;
+        }
+
+        if (!parsed) {
+            std::cerr << "usage: chess-server [--listen path|[host:]port] "
+                         "[--workers n] [--hash mb] [--max-nodes n] "
+                         "[--max-time ms]\n";
+
+            return 1;
+        }
+    }
+
+    Server server(options);
+
+    k_server = &server;
+
+    for (std::int32_t const signal : {SIGINT, SIGTERM})
+        std::signal(signal, [](std::int32_t) -> void { k_server->stop(); });
+
+    std::cerr << std::format(
+        "listening on {} with {} workers\n", options.endpoint, options.workers
+    );
+
+    if (!server.run()) {
+        std::cerr << std::format("cannot listen on {}\n", options.endpoint);
+
+        return 1;
+    }
+
+    std::cerr << std::format("stopped with {} sessions\n", server.size());
+
+    return 0;
+}
@@ -0,0 +1,322 @@
+#include "solver.h"
+
+#include "../board/board.h"
+#include "../vars.h"
+
+#include <algorithm>
+#include <bit>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <utility>
+
+static auto saturating_add(std::uint32_t const a, std::uint32_t const b)
+    -> std::uint32_t {
+    return a > std::numeric_limits<std::uint32_t>::max() - b
+               ? std::numeric_limits<std::uint32_t>::max()
+               : a + b;
+}
+
+static auto attacking(std::int32_t const remaining) -> bool {
+    return remaining % 2 == 1;
+}
+
+static auto gives_check(Move const &move) -> bool {
+    Undo const undo = move.make();
+
+    bool const check = in_check();
+
+    move.unmake(undo);
+
+    return check;
+}
+
+MateSolver::MateSolver(
+    std::size_t const memory, std::atomic<bool> const &stop
+)
+    : stop(stop) {
+    std::size_t const table_size = std::bit_floor(
+        std::max<std::size_t>(memory / 4 / sizeof(Entry), 1)
+    );
+
+    this->table.resize(table_size);
+    this->capacity = std::max<std::size_t>(
+        (memory - table_size * sizeof(Entry)) / sizeof(Node), 1
+    );
+    this->nodes.reserve(this->capacity);
+}
+
+auto MateSolver::solve(std::int32_t const moves) -> Solution {
+    Solution solution;
+
+    this->expanded = 0;
+
+    std::ranges::fill(this->table, Entry{});
+
+    for (std::int32_t mate = 1; mate <= moves; ++mate) {
+        solution.verdict = this->prove(mate * 2 - 1);
+        solution.nodes = this->expanded;
+
+        if (solution.verdict == Verdict::none)
+            continue;
+
+        if (solution.verdict == Verdict::mate) {
+            solution.moves = mate;
+            solution.line = this->line();
+        }
+
+        break;
+    }
+
+    return solution;
+}
+
+auto MateSolver::prove(std::int32_t const plies) -> Verdict {
+    this->nodes.clear();
+    this->nodes.emplace_back();
+
+    this->evaluate(this->nodes.front(), plies);
+
+    std::vector<std::pair<Move, Undo>> path;
+
+    while (this->nodes.front().proof && this->nodes.front().disproof) {
+        if (this->stop.load(std::memory_order::relaxed))
+            return Verdict::unknown;
+
+        std::uint32_t index = 0;
+        std::int32_t remaining = plies;
+
+        while (this->nodes[index].first != k_none) {
+            Node const &node = this->nodes[index];
+
+            auto const children = std::span(this->nodes).subspan(
+                node.first, node.children
+            );
+            auto const child =
+                attacking(remaining)
+                    ? std::ranges::min_element(children, {}, &Node::proof)
+                    : std::ranges::min_element(children, {}, &Node::disproof);
+
+            index = node.first +
+                    static_cast<std::uint32_t>(child - children.begin());
+
+            Move const move = child->move.decode();
+
+            path.emplace_back(move, move.make());
+
+            --remaining;
+        }
+
+        bool const grown = this->expand(index, remaining);
+
+        while (true) {
+            if (grown)
+                this->update(index, remaining);
+
+            if (path.empty())
+                break;
+
+            auto const &[move, undo] = path.back();
+
+            move.unmake(undo);
+            path.pop_back();
+
+            index = this->nodes[index].parent;
+            ++remaining;
+        }
+
+        if (!grown)
+            return Verdict::unknown;
+    }
+
+    return this->nodes.front().proof ? Verdict::none : Verdict::mate;
+}
+
+auto MateSolver::expand(std::uint32_t const index, std::int32_t const remaining)
+    -> bool {
+    std::vector<Move> moves = legal_moves();
+
+    if (attacking(remaining))
+        std::erase_if(moves, [](Move const &move) -> bool {
+            return !gives_check(move);
+        });
+
+    if (this->nodes.size() + moves.size() > this->capacity)
+        return false;
+
+    ++this->expanded;
+
+    this->nodes[index].first = static_cast<std::uint32_t>(this->nodes.size());
+    this->nodes[index].children = static_cast<std::uint8_t>(moves.size());
+
+    for (Move const &move : moves) {
+        Node &child = this->nodes.emplace_back();
+
+        child.parent = index;
+        child.move = PackedMove::encode(move);
+
+        Undo const undo = move.make();
+
+        this->evaluate(child, remaining - 1);
+
+        move.unmake(undo);
+    }
+
+    return true;
+}
+
+void MateSolver::evaluate(Node &node, std::int32_t const remaining) {
+    if (Entry const *entry = this->probe()) {
+        if (entry->state == State::proven && entry->plies <= remaining) {
+            node.proof = 0;
+            node.disproof = k_infinity;
+            node.distance = entry->plies;
+
+            return;
+        }
+
+        if (entry->state == State::disproven && entry->plies >= remaining) {
+            node.proof = k_infinity;
+            node.disproof = 0;
+
+            return;
+        }
+    }
+
+    if (attacking(remaining)) {
+        node.proof = node.disproof = 1;
+
+        return;
+    }
+
+    std::size_t const moves = legal_moves().size();
+
+    if (!moves && in_check()) {
+        node.proof = 0;
+        node.disproof = k_infinity;
+        node.distance = 0;
+    } else if (!moves || !remaining) {
+        node.proof = k_infinity;
+        node.disproof = 0;
+    } else {
+        node.proof = static_cast<std::uint32_t>(moves);
+        node.disproof = 1;
+    }
+}
+
+void MateSolver::update(
+    std::uint32_t const index, std::int32_t const remaining
+) {
+    Node &node = this->nodes[index];
+
+    auto const children =
+        std::span(this->nodes).subspan(node.first, node.children);
+
+    bool const attacker = attacking(remaining);
+
+    node.proof = attacker ? k_infinity : 0;
+    node.disproof = attacker ? 0 : k_infinity;
+
+    for (Node const &child : children)
+        if (attacker) {
+            node.proof = std::min(node.proof, child.proof);
+            node.disproof = saturating_add(node.disproof, child.disproof);
+        } else {
+            node.proof = saturating_add(node.proof, child.proof);
+            node.disproof = std::min(node.disproof, child.disproof);
+        }
+
+    if (node.disproof == 0) {
+        this->store(State::disproven, remaining, {});
+
+        return;
+    }
+
+    if (node.proof != 0)
+        return;
+
+    Node const *best = nullptr;
+
+    for (Node const &child : children)
+        if (child.proof == 0 &&
+            (!best || (attacker ? child.distance < best->distance
+                                : child.distance > best->distance)))
+            best = &child;
+
+    node.distance = static_cast<std::uint8_t>(best->distance + 1);
+
+    this->store(State::proven, node.distance, best->move);
+}
+
+auto MateSolver::line() -> std::vector<Move> {
+    std::vector<Move> line;
+    std::vector<std::pair<Move, Undo>> path;
+
+    std::uint32_t index = 0;
+
+    while (true) {
+        std::optional<PackedMove> packed;
+
+        if (index != k_none && this->nodes[index].first != k_none) {
+            Node const &node = this->nodes[index];
+
+            auto const children =
+                std::span(this->nodes).subspan(node.first, node.children);
+            auto const child = std::ranges::find_if(
+                children,
+                [&node](Node const &child) -> bool {
+                    return child.proof == 0 &&
+                           child.distance + 1 == node.distance;
+                }
+            );
+
+            if (child != children.end()) {
+                packed = child->move;
+                index = node.first + static_cast<std::uint32_t>(
+                                         child - children.begin()
+                                     );
+            }
+        } else if (Entry const *entry = this->probe();
+                   entry && entry->state == State::proven && entry->plies) {
+            packed = entry->move;
+            index = k_none;
+        }
+
+        if (!packed)
+            break;
+
+        Move const move = packed->decode();
+
+        line.push_back(move);
+        path.emplace_back(move, move.make());
+    }
+
+    for (auto const &[move, undo] : path | std::views::reverse)
+        move.unmake(undo);
+
+    return line;
+}
+
+auto MateSolver::probe() const -> Entry const * {
+    Entry const &entry = this->table[k_hash & (this->table.size() - 1)];
+
+    return entry.state != State::empty && entry.hash == k_hash ? &entry
+                                                               : nullptr;
+}
+
+void MateSolver::store(
+    State const state, std::int32_t const plies, PackedMove const move
+) {
+    Entry &entry = this->table[k_hash & (this->table.size() - 1)];
+
+    if (entry.state == State::proven && entry.hash != k_hash &&
+        state != State::proven)
+        return;
+
+    entry = {
+        .hash = k_hash,
+        .move = move,
+        .state = state,
+        .plies = static_cast<std::uint8_t>(plies),
+    };
+}
@@ -0,0 +1,75 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "../board/zobrist.h"
+#include "../move/move.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+enum class Verdict : std::uint8_t { mate, none, unknown };
+
+struct Solution final {
+    Verdict verdict = Verdict::unknown;
+    std::int32_t moves = 0;
+    std::vector<Move> line;
+    std::uint64_t nodes = 0;
+};
+
+class MateSolver final {
+  public:
+    MateSolver(std::size_t memory, std::atomic<bool> const &stop);
+
+    [[nodiscard]] auto solve(std::int32_t moves) -> Solution;
+
+  private:
+    inline static std::uint32_t constexpr k_infinity =
+        std::numeric_limits<std::uint32_t>::max();
+    inline static std::uint32_t constexpr k_none =
+        std::numeric_limits<std::uint32_t>::max();
+
+    struct Node final {
+        std::uint32_t proof = 1;
+        std::uint32_t disproof = 1;
+        std::uint32_t parent = k_none;
+        std::uint32_t first = k_none;
+        PackedMove move;
+        std::uint8_t children = 0;
+        std::uint8_t distance = 0;
+    };
+
+    enum class State : std::uint8_t { empty, proven, disproven };
+
+    struct Entry final {
+        Hash hash = 0;
+        PackedMove move;
+        State state = State::empty;
+        std::uint8_t plies = 0;
+    };
+
+    std::atomic<bool> const &stop;
+    std::vector<Node> nodes;
+    std::size_t capacity = 0;
+    std::vector<Entry> table;
+    std::uint64_t expanded = 0;
+
+    [[nodiscard]] auto prove(std::int32_t plies) -> Verdict;
+
+    [[nodiscard]] auto expand(std::uint32_t index, std::int32_t remaining)
+        -> bool;
+
+    void evaluate(Node &node, std::int32_t remaining);
+
+    void update(std::uint32_t index, std::int32_t remaining);
+
+    [[nodiscard]] auto line() -> std::vector<Move>;
+
+    [[nodiscard]] auto probe() const -> Entry const *;
+
+    void store(State state, std::int32_t plies, PackedMove move);
+};
+
+#endif // SOLVER_H
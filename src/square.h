@@ -2,6 +2,7 @@
 #define SQUARE_H
 
 #include <compare>
+#include <cstddef>
 #include <cstdint>
 #include <format>
 #include <string>
@@ -10,12 +11,38 @@ using Rank = std::int32_t;
 using File = std::int32_t;
 
 struct Square final {
-    Rank rank;
-    File file;
+    std::uint8_t index = 0;
+
+    constexpr Square() = default;
+
+    constexpr explicit Square(std::size_t const index)
+        : index(static_cast<std::uint8_t>(index)) {}
+
+    constexpr Square(Rank const rank, File const file)
+        : index(static_cast<std::uint8_t>(rank * 8 + file)) {}
+
+    [[nodiscard]] constexpr auto rank() const -> Rank {
+        return this->index >> 3;
+    }
+
+    [[nodiscard]] constexpr auto file() const -> File {
+        return this->index & 7;
+    }
+
+    [[nodiscard]] constexpr auto mirror() const -> Square {
+        return Square(static_cast<std::size_t>(this->index ^ 56));
+    }
+
+    [[nodiscard]] constexpr auto offset(Rank const rank, File const file) const
+        -> Square {
+        return {this->rank() + rank, this->file() + file};
+    }
+
+    [[nodiscard]] constexpr operator std::size_t() const { return this->index; }
 
     [[nodiscard]] explicit operator std::string() const {
         return std::format(
-            "{}{}", static_cast<char>('a' + this->file), 8 - this->rank
+            "{}{}", static_cast<char>('a' + this->file()), 8 - this->rank()
         );
     }
 
@@ -24,4 +51,8 @@ struct Square final {
     [[nodiscard]] auto operator<=>(Square const &) const = default;
 };
 
-#endif // SQUARE_H
\ No newline at end of file
+static_assert(sizeof(Square) == 1);
+
+inline static Square constexpr k_no_square{std::size_t{64}};
+
+#endif // SQUARE_H
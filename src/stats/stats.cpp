@@ -0,0 +1,201 @@
+#include "stats.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <string_view>
+#include <vector>
+
+struct Sample final {
+    std::string label;
+    Counters counters;
+    std::chrono::nanoseconds elapsed;
+};
+
+static std::atomic<Shard *> k_shards = nullptr;
+
+static std::mutex k_samples_mutex;
+static std::vector<Sample> k_samples;
+
+#ifdef CHESS_COUNTERS
+struct Release final {
+    ~Release() {
+        if (k_shard)
+            k_shard->in_use.store(false, std::memory_order::release);
+
+        k_shard = nullptr;
+    }
+};
+
+struct Dump final {
+    ~Dump() {
+        if (char const *path = std::getenv("CHESS_STATS"))
+            std::ofstream(path) << counters_json();
+    }
+};
+
+static Dump const k_dump;
+
+void *operator new(std::size_t const size) {
+    count(Counter::allocations);
+
+    if (void *pointer = std::malloc(size ? size : 1))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t const size, std::align_val_t const alignment) {
+    count(Counter::allocations);
+
+    auto const align = static_cast<std::size_t>(alignment);
+
+    if (void *pointer =
+            std::aligned_alloc(align, (std::max(size, align) + align - 1) /
+                                          align * align))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *const pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *const pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *const pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(
+    void *const pointer, std::size_t, std::align_val_t
+) noexcept {
+    std::free(pointer);
+}
+#endif
+
+auto acquire_shard() -> Shard * {
+#ifdef CHESS_COUNTERS
+    thread_local Release const release;
+#endif
+
+    for (Shard *shard = k_shards.load(std::memory_order::acquire); shard;
+         shard = shard->next)
+        if (bool expected = false; shard->in_use.compare_exchange_strong(
+                expected, true, std::memory_order::acquire
+            ))
+            return shard;
+
+    auto *shard = new (std::malloc(sizeof(Shard))) Shard;
+
+    shard->in_use.store(true, std::memory_order::relaxed);
+    shard->next = k_shards.load(std::memory_order::relaxed);
+
+    while (!k_shards.compare_exchange_weak(
+        shard->next, shard, std::memory_order::release,
+        std::memory_order::relaxed
+    ))
+        ;
+
+    return shard;
+}
+
+auto counters_enabled() -> bool {
+#ifdef CHESS_COUNTERS
+    return true;
+#else
+    return false;
+#endif
+}
+
+auto counters() -> Counters {
+    Counters totals{};
+
+    for (Shard const *shard = k_shards.load(std::memory_order::acquire); shard;
+         shard = shard->next)
+        for (std::size_t i = 0; i < k_counter_count; ++i)
+            totals[i] += shard->values[i].load(std::memory_order::relaxed);
+
+    return totals;
+}
+
+auto thread_counters() -> Counters {
+    Counters values{};
+
+    if (!k_shard)
+        return values;
+
+    for (std::size_t i = 0; i < k_counter_count; ++i)
+        values[i] = k_shard->values[i].load(std::memory_order::relaxed);
+
+    return values;
+}
+
+void record_sample(
+    std::string label, Counters const &counters,
+    std::chrono::nanoseconds const elapsed
+) {
+    std::lock_guard const lock(k_samples_mutex);
+
+    k_samples.push_back({std::move(label), counters, elapsed});
+}
+
+static auto json_string(std::string_view const text) -> std::string {
+    std::string json = "\"";
+
+    for (char const c : text) {
+        switch (c) {
+        case '"':
+            json += "\\\"";
+            break;
+        case '\\':
+            json += "\\\\";
+            break;
+        case '\t':
+            json += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+                json += std::format("\\u{:04x}", c);
+            else
+                json += c;
+        }
+    }
+
+    return json + '"';
+}
+
+static auto counters_object(Counters const &values) -> std::string {
+    std::string json = "{";
+
+    for (std::size_t i = 0; i < k_counter_count; ++i)
+        json += std::format(
+            "{}{}: {}", i ? ", " : "", json_string(k_counter_names[i]),
+            values[i]
+        );
+
+    return json + "}";
+}
+
+auto counters_json() -> std::string {
+    std::string json = std::format(
+        "{{\n  \"enabled\": {},\n  \"totals\": {},\n  \"samples\": [",
+        counters_enabled(), counters_object(counters())
+    );
+
+    std::lock_guard const lock(k_samples_mutex);
+
+    for (std::size_t i = 0; i < k_samples.size(); ++i)
+        json += std::format(
+            "{}\n    {{\"label\": {}, \"elapsed_ns\": {}, \"counters\": {}}}",
+            i ? "," : "", json_string(k_samples[i].label),
+            k_samples[i].elapsed.count(),
+            counters_object(k_samples[i].counters)
+        );
+
+    return json + "\n  ]\n}\n";
+}
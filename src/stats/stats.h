@@ -0,0 +1,76 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+enum class Counter : std::uint8_t {
+    get_moves,
+    is_valid,
+    is_checked,
+    allocations,
+    hash_probes,
+    hash_hits,
+    pawn_probes,
+    pawn_hits,
+    nodes,
+};
+
+inline static std::size_t constexpr k_counter_count = 9;
+
+inline static std::array<std::string_view, k_counter_count> constexpr
+    k_counter_names{
+        "get_moves",   "is_valid",    "is_checked",
+        "allocations", "hash_probes", "hash_hits",
+        "pawn_probes", "pawn_hits",   "nodes",
+    };
+
+using Counters = std::array<std::uint64_t, k_counter_count>;
+
+struct Shard final {
+    std::array<std::atomic<std::uint64_t>, k_counter_count> values{};
+    std::atomic<bool> in_use = false;
+    Shard *next = nullptr;
+};
+
+inline thread_local Shard *k_shard = nullptr;
+
+[[nodiscard]] auto acquire_shard() -> Shard *;
+
+inline void count(Counter const counter, std::uint64_t const amount = 1) {
+#ifdef CHESS_COUNTERS
+    if (!k_shard) [[unlikely]]
+        k_shard = acquire_shard();
+
+    std::atomic<std::uint64_t> &value =
+        k_shard->values[static_cast<std::size_t>(counter)];
+
+    value.store(
+        value.load(std::memory_order::relaxed) + amount,
+        std::memory_order::relaxed
+    );
+#else
+    (void)counter;
+    (void)amount;
+#endif
+}
+
+[[nodiscard]] auto counters_enabled() -> bool;
+
+[[nodiscard]] auto counters() -> Counters;
+
+[[nodiscard]] auto thread_counters() -> Counters;
+
+void record_sample(
+    std::string label, Counters const &counters,
+    std::chrono::nanoseconds elapsed
+);
+
+[[nodiscard]] auto counters_json() -> std::string;
+
+#endif // STATS_H
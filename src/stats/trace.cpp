@@ -0,0 +1,117 @@
+#include "trace.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <format>
+#include <fstream>
+#include <new>
+
+struct TraceEvent final {
+    char const *name = nullptr;
+    std::int64_t start = 0;
+    std::int64_t end = 0;
+    std::uint32_t thread = 0;
+};
+
+static std::size_t constexpr k_trace_capacity = std::size_t{1} << 16;
+
+struct TraceBuffer final {
+    std::array<TraceEvent, k_trace_capacity> events{};
+    std::uint64_t written = 0;
+    std::atomic<bool> in_use = false;
+    TraceBuffer *next = nullptr;
+};
+
+static std::atomic<TraceBuffer *> k_buffers = nullptr;
+static std::atomic<std::uint32_t> k_threads = 0;
+
+static thread_local TraceBuffer *k_buffer = nullptr;
+
+struct Release final {
+    ~Release() {
+        if (k_buffer)
+            k_buffer->in_use.store(false, std::memory_order::release);
+
+        k_buffer = nullptr;
+    }
+};
+
+struct Dump final {
+    ~Dump() {
+        if (char const *path = std::getenv("CHESS_TRACE"))
+            std::ofstream(path) << trace_json();
+    }
+};
+
+static Dump const k_dump;
+
+static auto acquire_buffer() -> TraceBuffer * {
+    thread_local Release const release;
+
+    for (TraceBuffer *buffer = k_buffers.load(std::memory_order::acquire);
+         buffer; buffer = buffer->next)
+        if (bool expected = false; buffer->in_use.compare_exchange_strong(
+                expected, true, std::memory_order::acquire
+            ))
+            return buffer;
+
+    auto *buffer = new (std::malloc(sizeof(TraceBuffer))) TraceBuffer;
+
+    buffer->in_use.store(true, std::memory_order::relaxed);
+    buffer->next = k_buffers.load(std::memory_order::relaxed);
+
+    while (!k_buffers.compare_exchange_weak(
+        buffer->next, buffer, std::memory_order::release,
+        std::memory_order::relaxed
+    ))
+        ;
+
+    return buffer;
+}
+
+void record_span(
+    char const *name, std::int64_t const start, std::int64_t const end
+) {
+    thread_local std::uint32_t const thread = ++k_threads;
+
+    if (!k_buffer) [[unlikely]]
+        k_buffer = acquire_buffer();
+
+    k_buffer->events[k_buffer->written++ % k_trace_capacity] = {
+        .name = name,
+        .start = start,
+        .end = end,
+        .thread = thread,
+    };
+}
+
+auto trace_json() -> std::string {
+    std::string json = "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+
+    bool first = true;
+
+    for (TraceBuffer const *buffer = k_buffers.load(std::memory_order::acquire);
+         buffer; buffer = buffer->next) {
+        std::uint64_t const written = buffer->written;
+
+        for (std::uint64_t i = written > k_trace_capacity
+                                   ? written - k_trace_capacity
+                                   : 0;
+             i < written; ++i) {
+            TraceEvent const &event = buffer->events[i % k_trace_capacity];
+
+            json += std::format(
+                "{}\n  {{\"name\": \"{}\", \"ph\": \"X\", \"pid\": 1, "
+                "\"tid\": {}, \"ts\": {:.3f}, \"dur\": {:.3f}}}",
+                first ? "" : ",", event.name, event.thread,
+                static_cast<double>(event.start) / 1000,
+                static_cast<double>(event.end - event.start) / 1000
+            );
+
+            first = false;
+        }
+    }
+
+    return json + "\n]}\n";
+}
@@ -0,0 +1,42 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+inline bool const k_tracing = std::getenv("CHESS_TRACE") != nullptr;
+
+[[nodiscard]] inline auto trace_clock() -> std::int64_t {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()
+    )
+        .count();
+}
+
+void record_span(char const *name, std::int64_t start, std::int64_t end);
+
+[[nodiscard]] auto trace_json() -> std::string;
+
+class TraceSpan final {
+  public:
+    explicit TraceSpan(char const *name)
+        : name(k_tracing ? name : nullptr),
+          start(this->name ? trace_clock() : 0) {}
+
+    TraceSpan(TraceSpan const &) = delete;
+
+    auto operator=(TraceSpan const &) -> TraceSpan & = delete;
+
+    ~TraceSpan() {
+        if (this->name) [[unlikely]]
+            record_span(this->name, this->start, trace_clock());
+    }
+
+  private:
+    char const *name;
+    std::int64_t start;
+};
+
+#endif // TRACE_H
@@ -0,0 +1,281 @@
+#include "positions.h"
+
+#include "../board/board.h"
+#include "../pieces/pieces.h"
+#include "../vars.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static std::array<char, 4> constexpr k_magic{'C', 'H', 'S', 'L'};
+static std::uint32_t constexpr k_version = 1;
+
+static std::size_t constexpr k_flush_records = std::size_t{1} << 16;
+
+struct Header final {
+    std::array<char, 4> magic = k_magic;
+    std::uint32_t version = k_version;
+    std::uint64_t count = 0;
+};
+
+static_assert(sizeof(Header) == 16);
+
+static auto result(ArchivedGame const &game) -> std::optional<std::uint8_t> {
+    std::string_view const tag = game.tag("Result");
+
+    if (tag == "1-0")
+        return 2;
+
+    if (tag == "1/2-1/2")
+        return 1;
+
+    if (tag == "0-1")
+        return 0;
+
+    return std::nullopt;
+}
+
+auto LabelledPosition::piece(std::size_t const square) const -> std::uint8_t {
+    return this->squares[square / 2] >> (square % 2 * 4) & 15;
+}
+
+auto label_position(std::uint8_t const result) -> LabelledPosition {
+    LabelledPosition position{.result = result};
+
+    for (Square const &square : k_squares)
+        if (Piece const *piece = k_pieces[square])
+            position.squares[square / 2] |= static_cast<std::uint8_t>(
+                (static_cast<std::uint32_t>(piece->colour) * 8 +
+                 static_cast<std::uint32_t>(piece->type()) + 1)
+                << (square % 2 * 4)
+            );
+
+    return position;
+}
+
+static void label_game(
+    std::string_view const fen, std::span<PackedMove const> const moves,
+    std::size_t const skip, std::uint8_t const outcome,
+    std::vector<LabelledPosition> &records
+) {
+    (void)load_fen(fen.empty() ? k_start_fen : fen);
+
+    std::size_t ply = 0;
+
+    for (PackedMove const move : moves) {
+        if (ply++ >= skip && !move.is_capture() && !move.is_promotion() &&
+            !in_check())
+            records.push_back(label_position(outcome));
+
+        play(move.decode());
+    }
+}
+
+using Extractor = std::function<std::optional<std::uint64_t>(
+    std::size_t, std::vector<LabelledPosition> &
+)>;
+
+static auto extract(
+    char const *path, std::size_t const units, std::int32_t const threads,
+    Extractor const &extractor
+) -> std::optional<ExtractSummary> {
+    std::int32_t const fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0)
+        return std::nullopt;
+
+    ExtractSummary summary;
+
+    std::atomic<std::size_t> next = 0;
+    std::atomic<bool> failed = false;
+
+    std::mutex mutex;
+    std::uint64_t offset = sizeof(Header);
+
+    auto const flush = [&](std::vector<LabelledPosition> &records) -> void {
+        std::size_t const size = records.size() * sizeof(LabelledPosition);
+
+        std::lock_guard const lock(mutex);
+
+        if (pwrite(fd, records.data(), size, static_cast<off_t>(offset)) !=
+            static_cast<ssize_t>(size))
+            failed = true;
+
+        offset += size;
+        summary.positions += records.size();
+
+        records.clear();
+    };
+
+    std::vector<std::thread> workers;
+
+    for (std::int32_t i = 0; i < std::max(threads, 1); ++i)
+        workers.emplace_back([&extractor, &next, &failed, &flush, &mutex,
+                              &summary, units]() -> void {
+            std::vector<LabelledPosition> records;
+            std::uint64_t games = 0;
+
+            records.reserve(k_flush_records);
+
+            for (std::size_t index = next++; index < units; index = next++) {
+                std::optional<std::uint64_t> const extracted =
+                    extractor(index, records);
+
+                if (!extracted)
+                    failed = true;
+                else
+                    games += *extracted;
+
+                if (records.size() >= k_flush_records)
+                    flush(records);
+            }
+
+            if (!records.empty())
+                flush(records);
+
+            std::lock_guard const lock(mutex);
+
+            summary.games += games;
+
+            clear_board();
+        });
+
+    for (std::thread &worker : workers)
+        worker.join();
+
+    Header const header{.count = summary.positions};
+
+    if (pwrite(fd, &header, sizeof(Header), 0) !=
+        static_cast<ssize_t>(sizeof(Header)))
+        failed = true;
+
+    close(fd);
+
+    if (failed)
+        return std::nullopt;
+
+    return summary;
+}
+
+auto extract_positions(
+    ArchiveReader const &archive, char const *path, std::int32_t const skip,
+    std::int32_t const threads
+) -> std::optional<ExtractSummary> {
+    return extract(
+        path, archive.size(), threads,
+        [&archive, skip](
+            std::size_t const index, std::vector<LabelledPosition> &records
+        ) -> std::optional<std::uint64_t> {
+            std::optional<ArchivedGame> const game = archive.game(index);
+
+            if (!game)
+                return std::nullopt;
+
+            std::optional<std::uint8_t> const outcome = result(*game);
+
+            if (!outcome)
+                return 0;
+
+            label_game(
+                game->tag("FEN"), game->moves, static_cast<std::size_t>(skip),
+                *outcome, records
+            );
+
+            return 1;
+        }
+    );
+}
+
+auto extract_positions(
+    StreamReader const &stream, char const *path, std::int32_t const skip,
+    std::int32_t const threads
+) -> std::optional<ExtractSummary> {
+    return extract(
+        path, stream.size(), threads,
+        [&stream, skip](
+            std::size_t const index, std::vector<LabelledPosition> &records
+        ) -> std::optional<std::uint64_t> {
+            std::optional<std::vector<ScoredGame>> const games =
+                stream.games(index);
+
+            if (!games)
+                return std::nullopt;
+
+            for (ScoredGame const &game : *games)
+                label_game(
+                    k_start_fen, game.moves,
+                    game.opening + static_cast<std::size_t>(skip), game.result,
+                    records
+                );
+
+            return games->size();
+        }
+    );
+}
+
+PositionFile::~PositionFile() { munmap(this->mapping, this->length); }
+
+auto PositionFile::open(char const *path) -> PositionFile * {
+    std::int32_t const fd = ::open(path, O_RDONLY);
+
+    if (fd < 0)
+        return nullptr;
+
+    struct stat status{};
+
+    if (fstat(fd, &status) != 0 ||
+        static_cast<std::size_t>(status.st_size) < sizeof(Header)) {
+        close(fd);
+
+        return nullptr;
+    }
+
+    auto const length = static_cast<std::size_t>(status.st_size);
+
+    void *mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+        return nullptr;
+
+    auto const *bytes = static_cast<char const *>(mapping);
+
+    Header header;
+    std::memcpy(&header, bytes, sizeof(Header));
+
+    if (header.magic != k_magic || header.version != k_version ||
+        header.count > (length - sizeof(Header)) / sizeof(LabelledPosition)) {
+        munmap(mapping, length);
+
+        return nullptr;
+    }
+
+    madvise(mapping, length, MADV_SEQUENTIAL);
+
+    auto *file = new PositionFile;
+
+    file->mapping = mapping;
+    file->length = length;
+    file->records = {
+        reinterpret_cast<LabelledPosition const *>(bytes + sizeof(Header)),
+        header.count
+    };
+
+    return file;
+}
+
+auto PositionFile::positions() const -> std::span<LabelledPosition const> {
+    return this->records;
+}
@@ -0,0 +1,60 @@
+#ifndef POSITIONS_H
+#define POSITIONS_H
+
+#include "../archive/archive.h"
+#include "../selfplay/stream.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+struct LabelledPosition final {
+    std::array<std::uint8_t, 32> squares{};
+    std::uint8_t result = 0;
+
+    [[nodiscard]] auto piece(std::size_t square) const -> std::uint8_t;
+};
+
+static_assert(sizeof(LabelledPosition) == 33);
+
+[[nodiscard]] auto label_position(std::uint8_t result) -> LabelledPosition;
+
+struct ExtractSummary final {
+    std::uint64_t games = 0;
+    std::uint64_t positions = 0;
+};
+
+[[nodiscard]] auto extract_positions(
+    ArchiveReader const &archive, char const *path, std::int32_t skip,
+    std::int32_t threads
+) -> std::optional<ExtractSummary>;
+
+[[nodiscard]] auto extract_positions(
+    StreamReader const &stream, char const *path, std::int32_t skip,
+    std::int32_t threads
+) -> std::optional<ExtractSummary>;
+
+class PositionFile final {
+  public:
+    PositionFile(PositionFile const &) = delete;
+
+    auto operator=(PositionFile const &) -> PositionFile & = delete;
+
+    ~PositionFile();
+
+    [[nodiscard]] static auto open(char const *path) -> PositionFile *;
+
+    [[nodiscard]] auto positions() const
+        -> std::span<LabelledPosition const>;
+
+  private:
+    void *mapping = nullptr;
+    std::size_t length = 0;
+    std::span<LabelledPosition const> records;
+
+    PositionFile() = default;
+};
+
+#endif // POSITIONS_H
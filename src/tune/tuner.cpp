@@ -0,0 +1,360 @@
+#include "tuner.h"
+
+#include "../board/board.h"
+#include "../eval/pawns.h"
+#include "../eval/tables.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <format>
+#include <numeric>
+#include <string_view>
+#include <thread>
+
+static std::size_t constexpr k_padding = k_terms;
+
+static double constexpr k_first_decay = 0.9;
+static double constexpr k_second_decay = 0.999;
+static double constexpr k_epsilon = 1e-8;
+
+static double constexpr k_min_scale = 1e-4;
+static double constexpr k_max_scale = 0.05;
+static std::int32_t constexpr k_scale_iterations = 40;
+
+static std::string_view constexpr k_piece_letters = "pnbrqk";
+
+static auto sigmoid(double const x) -> double { return 1 / (1 + std::exp(-x)); }
+
+template <typename Work>
+static void parallel(
+    std::size_t const size, std::int32_t const threads, Work const &work
+) {
+    auto const count = static_cast<std::size_t>(std::max(threads, 1));
+
+    std::vector<std::thread> workers;
+
+    for (std::size_t i = 0; i < count; ++i)
+        workers.emplace_back([&work, i, first = size * i / count,
+                              last = size * (i + 1) / count]() -> void {
+            work(i, first, last);
+        });
+
+    for (std::thread &worker : workers)
+        worker.join();
+}
+
+static auto evaluate(auto const &features, Weights const &weights) -> double {
+    double middlegame = 0;
+    double endgame = 0;
+
+    for (std::size_t i = 0; i < features.terms.size(); ++i) {
+        middlegame += features.signs[i] * weights[0][features.terms[i]];
+        endgame += features.signs[i] * weights[1][features.terms[i]];
+    }
+
+    return middlegame * features.phase + endgame * (1 - features.phase) +
+           features.offset;
+}
+
+static auto placement(LabelledPosition const &position) -> std::string {
+    std::string fen;
+
+    for (std::size_t rank = 0; rank < 8; ++rank) {
+        std::int32_t empty = 0;
+
+        for (std::size_t file = 0; file < 8; ++file) {
+            std::uint8_t const piece = position.piece(rank * 8 + file);
+
+            if (!piece) {
+                ++empty;
+
+                continue;
+            }
+
+            if (empty)
+                fen += static_cast<char>('0' + empty);
+
+            empty = 0;
+
+            char const letter = k_piece_letters[(piece - 1) % 8];
+
+            fen += piece > 8 ? letter
+                             : static_cast<char>(std::toupper(letter));
+        }
+
+        if (empty)
+            fen += static_cast<char>('0' + empty);
+
+        if (rank < 7)
+            fen += '/';
+    }
+
+    return fen + " w - - 0 1";
+}
+
+static void write_values(
+    std::string &header, std::string_view const type,
+    std::string_view const name, std::array<Score, 6> const &values
+) {
+    header += std::format(
+        "inline static std::array<{}, 6> constexpr {}{{\n    ", type, name
+    );
+
+    for (Score const value : values)
+        header += std::format("{}, ", value);
+
+    header.back() = '\n';
+    header += "};\n";
+}
+
+static void write_tables(
+    std::string &header, std::string_view const name,
+    std::array<double, k_terms + 1> const &weights,
+    std::array<Score, 6> const &values
+) {
+    header += std::format(
+        "\ninline static std::array<Table, 6> constexpr {}{{\n", name
+    );
+
+    for (std::size_t type = 0; type < values.size(); ++type) {
+        std::array<Score, 64> table{};
+        std::size_t width = 0;
+
+        for (std::size_t square = 0; square < table.size(); ++square) {
+            table[square] = static_cast<Score>(
+                std::lround(weights[type * 64 + square]) - values[type]
+            );
+            width = std::max(width, std::format("{}", table[square]).size());
+        }
+
+        header += "    Table{\n";
+
+        for (std::size_t rank = 0; rank < 8; ++rank) {
+            header += "       ";
+
+            for (std::size_t file = 0; file < 8; ++file)
+                header +=
+                    std::format(" {:>{}},", table[rank * 8 + file], width);
+
+            header += '\n';
+        }
+
+        header += "    },\n";
+    }
+
+    header += "};\n";
+}
+
+auto initial_weights() -> Weights {
+    Weights weights{};
+
+    for (std::size_t type = 0; type < 6; ++type)
+        for (std::size_t square = 0; square < 64; ++square) {
+            weights[0][type * 64 + square] =
+                k_middlegame_values[type] +
+                k_middlegame_tables[type][square];
+            weights[1][type * 64 + square] =
+                k_endgame_values[type] + k_endgame_tables[type][square];
+        }
+
+    return weights;
+}
+
+auto tables_header(Weights const &weights) -> std::string {
+    std::string header = "#ifndef TABLES_H\n#define TABLES_H\n\n"
+                         "#include <array>\n#include <cstdint>\n\n"
+                         "using Score = std::int32_t;\n\n"
+                         "using Table = std::array<Score, 64>;\n\n";
+
+    write_values(header, "Score", "k_middlegame_values", k_middlegame_values);
+    write_values(header, "Score", "k_endgame_values", k_endgame_values);
+    write_values(header, "std::int32_t", "k_phase_values", k_phase_values);
+    header += std::format(
+        "inline static std::int32_t constexpr k_max_phase = {};\n",
+        k_max_phase
+    );
+
+    write_tables(
+        header, "k_middlegame_tables", weights[0], k_middlegame_values
+    );
+    write_tables(header, "k_endgame_tables", weights[1], k_endgame_values);
+
+    return header + "\n#endif // TABLES_H\n";
+}
+
+Tuner::Tuner(
+    std::span<LabelledPosition const> const positions,
+    std::int32_t const threads
+)
+    : features(positions.size()), threads(threads) {
+    parallel(
+        positions.size(), threads,
+        [this, positions](
+            std::size_t, std::size_t const first, std::size_t const last
+        ) -> void {
+            for (std::size_t index = first; index < last; ++index) {
+                LabelledPosition const &position = positions[index];
+                Features &features = this->features[index];
+
+                features.terms.fill(k_padding);
+
+                std::size_t slot = 0;
+                std::int32_t phase = 0;
+
+                for (std::size_t square = 0; square < 64; ++square) {
+                    std::uint8_t const piece = position.piece(square);
+                    std::size_t const type = (piece - 1) % 8;
+                    bool const black = piece > 8;
+
+                    if (!piece || type >= 6 || slot == features.terms.size())
+                        continue;
+
+                    features.terms[slot] = static_cast<std::uint16_t>(
+                        type * 64 + (black ? square ^ 56 : square)
+                    );
+                    features.signs[slot] = black ? -1 : 1;
+
+                    phase += k_phase_values[type];
+
+                    ++slot;
+                }
+
+                features.phase = static_cast<float>(
+                                     std::min(phase, k_max_phase)
+                                 ) /
+                                 k_max_phase;
+                features.result = static_cast<float>(position.result) / 2;
+
+                if (load_fen(placement(position)))
+                    features.offset =
+                        static_cast<float>(pawn_structure(Colour::white));
+            }
+
+            clear_board();
+        }
+    );
+}
+
+auto Tuner::size() const -> std::size_t { return this->features.size(); }
+
+auto Tuner::fit_scale(Weights const &weights) -> double {
+    double low = k_min_scale;
+    double high = k_max_scale;
+
+    for (std::int32_t i = 0; i < k_scale_iterations; ++i) {
+        double const left = low + (high - low) / 3;
+        double const right = high - (high - low) / 3;
+
+        this->scale = left;
+        double const left_loss = this->loss(weights);
+
+        this->scale = right;
+        double const right_loss = this->loss(weights);
+
+        if (left_loss < right_loss)
+            high = right;
+        else
+            low = left;
+    }
+
+    return this->scale = (low + high) / 2;
+}
+
+auto Tuner::loss(Weights const &weights) const -> double {
+    return this->gradient(weights, nullptr);
+}
+
+auto Tuner::tune(
+    Weights weights, TuneOptions const &options,
+    std::function<void(std::int32_t, double)> const &report
+) const -> Weights {
+    Weights gradient{};
+    Weights first{};
+    Weights second{};
+
+    for (std::int32_t epoch = 1; epoch <= options.epochs; ++epoch) {
+        double const loss = this->gradient(weights, &gradient);
+
+        double const first_bias = 1 - std::pow(k_first_decay, epoch);
+        double const second_bias = 1 - std::pow(k_second_decay, epoch);
+
+        for (std::size_t phase = 0; phase < weights.size(); ++phase)
+            for (std::size_t term = 0; term < k_terms; ++term) {
+                double const slope = gradient[phase][term];
+
+                first[phase][term] = k_first_decay * first[phase][term] +
+                                     (1 - k_first_decay) * slope;
+                second[phase][term] = k_second_decay * second[phase][term] +
+                                      (1 - k_second_decay) * slope * slope;
+
+                weights[phase][term] -=
+                    options.rate * first[phase][term] / first_bias /
+                    (std::sqrt(second[phase][term] / second_bias) + k_epsilon);
+            }
+
+        if (report)
+            report(epoch, loss);
+    }
+
+    return weights;
+}
+
+auto Tuner::gradient(Weights const &weights, Weights *gradient) const
+    -> double {
+    auto const count = static_cast<std::size_t>(std::max(this->threads, 1));
+
+    std::vector<Weights> partials(gradient ? count : 0);
+    std::vector<double> losses(count);
+
+    parallel(
+        this->features.size(), this->threads,
+        [this, &weights, gradient, &partials, &losses](
+            std::size_t const thread, std::size_t const first,
+            std::size_t const last
+        ) -> void {
+            double loss = 0;
+
+            for (std::size_t index = first; index < last; ++index) {
+                Features const &features = this->features[index];
+
+                double const estimate =
+                    sigmoid(this->scale * evaluate(features, weights));
+                double const error = features.result - estimate;
+
+                loss += error * error;
+
+                if (!gradient)
+                    continue;
+
+                double const slope =
+                    -2 * error * estimate * (1 - estimate) * this->scale;
+
+                for (std::size_t i = 0; i < features.terms.size(); ++i) {
+                    double const term = slope * features.signs[i];
+
+                    partials[thread][0][features.terms[i]] +=
+                        term * features.phase;
+                    partials[thread][1][features.terms[i]] +=
+                        term * (1 - features.phase);
+                }
+            }
+
+            losses[thread] = loss;
+        }
+    );
+
+    auto const size =
+        static_cast<double>(std::max<std::size_t>(this->features.size(), 1));
+
+    if (gradient) {
+        *gradient = {};
+
+        for (Weights const &partial : partials)
+            for (std::size_t phase = 0; phase < partial.size(); ++phase)
+                for (std::size_t term = 0; term < k_terms; ++term)
+                    (*gradient)[phase][term] += partial[phase][term] / size;
+    }
+
+    return std::accumulate(losses.begin(), losses.end(), 0.0) / size;
+}
@@ -0,0 +1,60 @@
+#ifndef TUNER_H
+#define TUNER_H
+
+#include "positions.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+inline static std::size_t constexpr k_terms = 6 * 64;
+
+using Weights = std::array<std::array<double, k_terms + 1>, 2>;
+
+struct TuneOptions final {
+    std::int32_t epochs = 1000;
+    double rate = 1;
+    std::int32_t threads = 1;
+};
+
+[[nodiscard]] auto initial_weights() -> Weights;
+
+[[nodiscard]] auto tables_header(Weights const &weights) -> std::string;
+
+class Tuner final {
+  public:
+    Tuner(std::span<LabelledPosition const> positions, std::int32_t threads);
+
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    auto fit_scale(Weights const &weights) -> double;
+
+    [[nodiscard]] auto loss(Weights const &weights) const -> double;
+
+    [[nodiscard]] auto tune(
+        Weights weights, TuneOptions const &options,
+        std::function<void(std::int32_t, double)> const &report = {}
+    ) const -> Weights;
+
+  private:
+    struct Features final {
+        std::array<std::uint16_t, 32> terms{};
+        std::array<std::int8_t, 32> signs{};
+        float phase = 0;
+        float offset = 0;
+        float result = 0;
+    };
+
+    std::vector<Features> features;
+    std::int32_t threads;
+    double scale = 1;
+
+    [[nodiscard]] auto gradient(Weights const &weights, Weights *gradient)
+        const -> double;
+};
+
+#endif // TUNER_H
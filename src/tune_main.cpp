@@ -0,0 +1,161 @@
+#include "archive/archive.h"
+#include "selfplay/stream.h"
+#include "tune/positions.h"
+#include "tune/tuner.h"
+
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <thread>
+
+static std::int32_t constexpr k_default_skip = 8;
+static std::int32_t constexpr k_report_interval = 50;
+
+static auto seconds_since(std::chrono::steady_clock::time_point const start)
+    -> double {
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now() - start
+    )
+        .count();
+}
+
+static auto extract(
+    char const *input_path, char const *positions_path,
+    std::int32_t const skip, std::int32_t const threads
+) -> std::int32_t {
+    std::unique_ptr<StreamReader> const stream(StreamReader::open(input_path));
+    std::unique_ptr<ArchiveReader> const archive(
+        stream ? nullptr : ArchiveReader::open(input_path)
+    );
+
+    if (!stream && !archive) {
+        std::cerr << std::format("cannot open {}\n", input_path);
+
+        return 1;
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+
+    std::optional<ExtractSummary> const summary =
+        stream ? extract_positions(*stream, positions_path, skip, threads)
+               : extract_positions(*archive, positions_path, skip, threads);
+
+    if (!summary) {
+        std::cerr << std::format("failed to write {}\n", positions_path);
+
+        return 1;
+    }
+
+    std::cerr << std::format(
+        "{} games, {} positions in {:.2f} s\n", summary->games,
+        summary->positions, seconds_since(start)
+    );
+
+    return 0;
+}
+
+static auto tune(
+    char const *positions_path, char const *header_path,
+    TuneOptions const &options
+) -> std::int32_t {
+    std::unique_ptr<PositionFile> const positions(
+        PositionFile::open(positions_path)
+    );
+
+    if (!positions) {
+        std::cerr << std::format("cannot open {}\n", positions_path);
+
+        return 1;
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+
+    Tuner tuner(positions->positions(), options.threads);
+
+    Weights const initial = initial_weights();
+
+    double const scale = tuner.fit_scale(initial);
+
+    std::cerr << std::format(
+        "{} positions loaded in {:.2f} s, scale {:.6f}, loss {:.6f}\n",
+        tuner.size(), seconds_since(start), scale, tuner.loss(initial)
+    );
+
+    Weights const tuned = tuner.tune(
+        initial, options,
+        [&start, &options](std::int32_t const epoch, double const loss)
+            -> void {
+            if (epoch % k_report_interval == 0 || epoch == options.epochs)
+                std::cerr << std::format(
+                    "epoch {} loss {:.6f} at {:.1f} s\n", epoch, loss,
+                    seconds_since(start)
+                );
+        }
+    );
+
+    std::ofstream file(header_path);
+
+    file << tables_header(tuned);
+
+    if (!file) {
+        std::cerr << std::format("cannot write {}\n", header_path);
+
+        return 1;
+    }
+
+    std::cerr << std::format(
+        "final loss {:.6f}, wrote {}\n", tuner.loss(tuned), header_path
+    );
+
+    return 0;
+}
+
+std::int32_t main(std::int32_t argc, char *argv[]) {
+    TuneOptions options{
+        .threads =
+            static_cast<std::int32_t>(std::thread::hardware_concurrency()),
+    };
+    std::int32_t skip = k_default_skip;
+    bool extracting = false;
+    char const *input = nullptr;
+    char const *output = nullptr;
+
+    for (std::int32_t i = 1; i < argc; ++i) {
+        std::string_view const argument = argv[i];
+
+        if (argument == "--extract") {
+            extracting = true;
+        } else if (argument == "--threads" && i + 1 < argc) {
+            options.threads = std::stoi(argv[++i]);
+        } else if (argument == "--epochs" && i + 1 < argc) {
+            options.epochs = std::stoi(argv[++i]);
+        } else if (argument == "--rate" && i + 1 < argc) {
+            options.rate = std::stod(argv[++i]);
+        } else if (argument == "--skip" && i + 1 < argc) {
+            skip = std::stoi(argv[++i]);
+        } else if (argument.starts_with("--")) {
+            std::cerr << std::format("unknown option {}\n", argument);
+
+            return 1;
+        } else if (!input) {
+            input = argv[i];
+        } else {
+            output = argv[i];
+        }
+    }
+
+    if (!input || !output) {
+        std::cerr << "usage: chess-tune --extract [--skip n] [--threads n] "
+                     "(archive|stream) positions\n"
+                     "       chess-tune [--epochs n] [--rate r] "
+                     "[--threads n] positions tables.h\n";
+
+        return 1;
+    }
+
+    return extracting ? extract(input, output, skip, options.threads)
+                      : tune(input, output, options);
+}
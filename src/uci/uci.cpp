@@ -0,0 +1,388 @@
+#include "uci.h"
+
+#include "../board/board.h"
+#include "../nnue/nnue.h"
+
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <string_view>
+
+template <typename Number>
+static auto parse_number(std::string_view const text)
+    -> std::optional<Number> {
+    Number number{};
+
+    auto const [end, error] =
+        std::from_chars(text.data(), text.data() + text.size(), number);
+
+    if (error != std::errc{})
+        return std::nullopt;
+
+    return number;
+}
+
+static auto format_score(Score const score) -> std::string {
+    if (std::abs(score) < k_mate - k_max_ply)
+        return std::format("cp {}", score);
+
+    std::int32_t const moves = (k_mate - std::abs(score) + 1) / 2;
+
+    return std::format("mate {}", score > 0 ? moves : -moves);
+}
+
+static auto format_pv(std::vector<Move> const &pv) -> std::string {
+    std::string text;
+
+    for (Move const &move : pv) {
+        if (!text.empty())
+            text += ' ';
+
+        text += to_uci(move);
+    }
+
+    return text;
+}
+
+Uci::Uci(std::istream &input, std::ostream &output)
+    : input(input), output(output), root(k_start_fen) {}
+
+Uci::~Uci() {
+    this->stop();
+    this->wait();
+
+    clear_board();
+}
+
+void Uci::loop() {
+    this->setup();
+
+    for (std::string line; std::getline(this->input, line);) {
+        std::istringstream arguments(line);
+        std::string command;
+
+        arguments >> command;
+
+        if (command == "uci") {
+            this->identify();
+        } else if (command == "isready") {
+            this->send("readyok");
+        } else if (command == "ucinewgame") {
+            this->stop();
+            this->wait();
+            this->table.clear();
+        } else if (command == "setoption") {
+            this->set_option(arguments);
+        } else if (command == "position") {
+            this->position(arguments);
+        } else if (command == "go") {
+            this->go(arguments);
+        } else if (command == "stop") {
+            this->stop();
+        } else if (command == "ponderhit") {
+            this->ponder_hit();
+        } else if (command == "quit") {
+            break;
+        } else if (!command.empty()) {
+            this->send(std::format("info string unknown command {}", command));
+        }
+    }
+}
+
+void Uci::send(std::string_view const line) {
+    std::lock_guard const lock(this->output_mutex);
+
+    this->output << line << std::endl;
+}
+
+void Uci::identify() {
+    this->send("id name chess");
+    this->send("id author chess developers");
+    this->send(
+        std::format(
+            "option name Hash type spin default {} min 1 max 65536",
+            k_default_hash
+        )
+    );
+    this->send(
+        std::format(
+            "option name Threads type spin default 1 min 1 max {}",
+            k_max_threads
+        )
+    );
+    this->send("option name Ponder type check default false");
+    this->send(
+        std::format(
+            "option name Move Overhead type spin default {} min 0 max {}",
+            k_default_overhead, k_max_overhead
+        )
+    );
+    this->send(
+        std::format(
+            "option name Move Time Cap type spin default 0 min 0 max {}",
+            k_max_cap
+        )
+    );
+    this->send("option name EvalFile type string default <empty>");
+    this->send("uciok");
+}
+
+void Uci::set_option(std::istringstream &arguments) {
+    std::string token;
+    std::string name;
+    std::string value;
+
+    arguments >> token;
+
+    while (arguments >> token && token != "value")
+        name += name.empty() ? token : ' ' + token;
+
+    std::getline(arguments >> std::ws, value);
+
+    this->stop();
+    this->wait();
+
+    if (name == "Hash") {
+        if (auto const size = parse_number<std::size_t>(value))
+            this->table.resize(std::clamp<std::size_t>(*size, 1, 65536));
+    } else if (name == "Threads") {
+        if (auto const threads = parse_number<std::int32_t>(value))
+            this->threads = std::clamp(*threads, 1, k_max_threads);
+    } else if (name == "Move Overhead") {
+        if (auto const overhead = parse_number<std::int32_t>(value))
+            this->overhead = std::chrono::milliseconds(
+                std::clamp(*overhead, 0, k_max_overhead)
+            );
+    } else if (name == "Move Time Cap") {
+        if (auto const cap = parse_number<std::int32_t>(value))
+            this->cap =
+                std::chrono::milliseconds(std::clamp(*cap, 0, k_max_cap));
+    } else if (name == "EvalFile") {
+        delete k_network;
+
+        k_network = value.empty() || value == "<empty>"
+                        ? nullptr
+                        : Network::load(value.c_str());
+
+        if (!k_network && !value.empty() && value != "<empty>")
+            this->send(std::format("info string failed to load {}", value));
+
+        this->setup();
+    } else if (name != "Ponder") {
+        this->send(std::format("info string unknown option {}", name));
+    }
+}
+
+void Uci::position(std::istringstream &arguments) {
+    std::string token;
+    std::string fen;
+
+    arguments >> token;
+
+    if (token == "startpos") {
+        fen = k_start_fen;
+
+        arguments >> token;
+    } else if (token == "fen") {
+        while (arguments >> token && token != "moves")
+            fen += fen.empty() ? token : ' ' + token;
+    } else {
+        return;
+    }
+
+    this->stop();
+    this->wait();
+
+    if (!load_fen(fen)) {
+        this->send(std::format("info string invalid fen {}", fen));
+        this->setup();
+
+        return;
+    }
+
+    this->root = fen;
+    this->moves.clear();
+
+    while (arguments >> token) {
+        std::optional<Move> const move = parse_uci(token);
+
+        if (!move) {
+            this->send(std::format("info string illegal move {}", token));
+
+            break;
+        }
+
+        play(*move);
+
+        this->moves.push_back(*move);
+    }
+}
+
+void Uci::go(std::istringstream &arguments) {
+    using std::chrono::milliseconds;
+
+    Limits limits{.overhead = this->overhead, .cap = this->cap};
+    bool ponder = false;
+
+    for (std::string token; arguments >> token;) {
+        std::int64_t value = 0;
+
+        if (token == "infinite") {
+            limits.infinite = true;
+        } else if (token == "ponder") {
+            ponder = true;
+        } else if (!(arguments >> value)) {
+            break;
+        } else if (token == "depth") {
+            limits.depth = std::clamp<std::int32_t>(value, 1, k_max_ply - 1);
+        } else if (token == "nodes") {
+            limits.nodes = value;
+        } else if (token == "movetime") {
+            limits.movetime = milliseconds(value);
+        } else if (token == "wtime") {
+            limits.time[static_cast<std::size_t>(Colour::white)] =
+                milliseconds(value);
+        } else if (token == "btime") {
+            limits.time[static_cast<std::size_t>(Colour::black)] =
+                milliseconds(value);
+        } else if (token == "winc") {
+            limits.increment[static_cast<std::size_t>(Colour::white)] =
+                milliseconds(value);
+        } else if (token == "binc") {
+            limits.increment[static_cast<std::size_t>(Colour::black)] =
+                milliseconds(value);
+        } else if (token == "movestogo") {
+            limits.moves_to_go = static_cast<std::int32_t>(value);
+        }
+    }
+
+    this->stop();
+    this->wait();
+
+    this->signals.stop = false;
+    this->signals.ponder = ponder;
+
+    this->worker = std::thread([this, limits]() -> void {
+        this->think(limits);
+    });
+}
+
+void Uci::stop() {
+    {
+        std::lock_guard const lock(this->mutex);
+
+        this->signals.stop = true;
+    }
+
+    this->released.notify_all();
+}
+
+void Uci::ponder_hit() {
+    {
+        std::lock_guard const lock(this->mutex);
+
+        this->signals.ponder = false;
+    }
+
+    this->released.notify_all();
+}
+
+void Uci::wait() {
+    if (this->worker.joinable())
+        this->worker.join();
+}
+
+void Uci::think(Limits const &limits) {
+    this->setup();
+
+    Limits split = limits;
+
+    if (limits.nodes)
+        split.nodes = std::max<std::uint64_t>(
+            limits.nodes / static_cast<std::uint64_t>(this->threads), 1
+        );
+
+    std::vector<std::unique_ptr<Searcher>> searchers;
+
+    for (std::int32_t i = 0; i < this->threads; ++i)
+        searchers.push_back(
+            std::make_unique<Searcher>(this->table, this->signals)
+        );
+
+    auto const nodes = [&searchers]() -> std::uint64_t {
+        std::uint64_t total = 0;
+
+        for (std::unique_ptr<Searcher> const &searcher : searchers)
+            total += searcher->nodes();
+
+        return total;
+    };
+
+    std::vector<std::thread> helpers;
+
+    for (std::unique_ptr<Searcher> &searcher : searchers | std::views::drop(1))
+        helpers.emplace_back([this, &split, &searcher]() -> void {
+            this->setup();
+
+            (void)searcher->search(split);
+
+            clear_board();
+        });
+
+    Result const result = searchers.front()->search(
+        split,
+        [this, &nodes](Info const &info) -> void {
+            std::uint64_t const total = nodes();
+            std::int64_t const milliseconds = info.elapsed.count();
+
+            this->send(
+                std::format(
+                    "info depth {} score {} nodes {} nps {} hashfull {} "
+                    "time {} pv {}",
+                    info.depth, format_score(info.score), total,
+                    total * 1000 / std::max<std::int64_t>(milliseconds, 1),
+                    this->table.hashfull(), milliseconds, format_pv(info.pv)
+                )
+            );
+        }
+    );
+
+    {
+        std::unique_lock lock(this->mutex);
+
+        this->released.wait(lock, [this, &limits]() -> bool {
+            return this->signals.stop ||
+                   (!limits.infinite && !this->signals.ponder);
+        });
+
+        this->signals.stop = true;
+    }
+
+    for (std::thread &helper : helpers)
+        helper.join();
+
+    if (result.pv.empty()) {
+        this->send("bestmove 0000");
+    } else if (result.pv.size() == 1) {
+        this->send(std::format("bestmove {}", to_uci(result.pv[0])));
+    } else {
+        this->send(
+            std::format(
+                "bestmove {} ponder {}", to_uci(result.pv[0]),
+                to_uci(result.pv[1])
+            )
+        );
+    }
+
+    clear_board();
+}
+
+void Uci::setup() const {
+    (void)load_fen(this->root);
+
+    for (Move const &move : this->moves)
+        play(move);
+}
@@ -0,0 +1,73 @@
+#ifndef UCI_H
+#define UCI_H
+
+#include "../move/move.h"
+#include "../search/search.h"
+#include "../search/table.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+class Uci final {
+  public:
+    Uci(std::istream &input, std::ostream &output);
+
+    ~Uci();
+
+    void loop();
+
+  private:
+    inline static std::size_t constexpr k_default_hash = 16;
+    inline static std::int32_t constexpr k_max_threads = 256;
+    inline static std::int32_t constexpr k_default_overhead = 20;
+    inline static std::int32_t constexpr k_max_overhead = 5000;
+    inline static std::int32_t constexpr k_max_cap = 3600000;
+
+    std::istream &input;
+    std::ostream &output;
+
+    TranspositionTable table{k_default_hash};
+    Signals signals;
+    std::int32_t threads = 1;
+    std::chrono::milliseconds overhead{k_default_overhead};
+    std::chrono::milliseconds cap{};
+
+    std::string root;
+    std::vector<Move> moves;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable released;
+    std::mutex output_mutex;
+
+    void send(std::string_view line);
+
+    void identify();
+
+    void set_option(std::istringstream &arguments);
+
+    void position(std::istringstream &arguments);
+
+    void go(std::istringstream &arguments);
+
+    void stop();
+
+    void ponder_hit();
+
+    void wait();
+
+    void think(Limits const &limits);
+
+    void setup() const;
+};
+
+#endif // UCI_H
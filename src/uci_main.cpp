@@ -0,0 +1,12 @@
+#include "uci/uci.h"
+
+#include <iostream>
+
+std::int32_t main() {
+    std::ios::sync_with_stdio(false);
+
+    Uci uci(std::cin, std::cout);
+    uci.loop();
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include "clock.h"
+
+#include <algorithm>
+#include <format>
+#include <string>
+#include <utility>
+
+#include <qtimer.h>
+
+static std::int32_t constexpr k_tick_interval = 100;
+
+static auto format_time(std::chrono::milliseconds const time) -> std::string {
+    using namespace std::chrono;
+
+    milliseconds const clamped = std::max(time, milliseconds{});
+    auto const minutes = duration_cast<std::chrono::minutes>(clamped);
+    auto const seconds =
+        duration_cast<std::chrono::seconds>(clamped - minutes);
+
+    if (clamped >= 10s)
+        return std::format("{}:{:02}", minutes.count(), seconds.count());
+
+    return std::format(
+        "{}.{}", seconds.count(),
+        duration_cast<milliseconds>(clamped - seconds).count() / 100
+    );
+}
+
+ChessClock::ChessClock(QWidget *parent) : QLabel(parent) {
+    this->timer = new QTimer(this);
+    this->timer->setInterval(k_tick_interval);
+
+    connect(this->timer, &QTimer::timeout, [this]() -> void {
+        this->tick();
+    });
+
+    this->setStyleSheet(
+        "QLabel {"
+        "   font-family : monospace;"
+        "}"
+    );
+
+    this->showTime();
+}
+
+void ChessClock::reset(
+    std::chrono::milliseconds const base,
+    std::chrono::milliseconds const increment
+) {
+    this->timer->stop();
+
+    this->times = {base, base};
+    this->bonus = increment;
+    this->running.reset();
+    this->fallen.reset();
+
+    this->showTime();
+}
+
+void ChessClock::press(Colour const colour) {
+    if (this->fallen)
+        return;
+
+    this->charge();
+
+    this->times[static_cast<std::size_t>(colour)] += this->bonus;
+
+    this->run(colour == Colour::white ? Colour::black : Colour::white);
+}
+
+void ChessClock::run(Colour const colour) {
+    if (this->fallen)
+        return;
+
+    this->charge();
+
+    this->running = colour;
+    this->since = Clock::now();
+    this->timer->start();
+
+    this->showTime();
+}
+
+void ChessClock::stop() {
+    this->charge();
+
+    this->running.reset();
+    this->timer->stop();
+
+    this->showTime();
+}
+
+auto ChessClock::remaining(Colour const colour) const
+    -> std::chrono::milliseconds {
+    std::chrono::milliseconds time =
+        this->times[static_cast<std::size_t>(colour)];
+
+    if (this->running == colour)
+        time -= std::chrono::duration_cast<std::chrono::milliseconds>(
+            Clock::now() - this->since
+        );
+
+    return time;
+}
+
+auto ChessClock::increment() const -> std::chrono::milliseconds {
+    return this->bonus;
+}
+
+auto ChessClock::flagged() const -> std::optional<Colour> {
+    return this->fallen;
+}
+
+void ChessClock::setFlagHandler(std::function<void(Colour)> handler) {
+    this->handler = std::move(handler);
+}
+
+void ChessClock::charge() {
+    if (!this->running)
+        return;
+
+    auto const spent = std::chrono::duration_cast<std::chrono::milliseconds>(
+        Clock::now() - this->since
+    );
+
+    this->times[static_cast<std::size_t>(*this->running)] -= spent;
+    this->since += spent;
+}
+
+void ChessClock::tick() {
+    this->charge();
+
+    if (this->running &&
+        this->times[static_cast<std::size_t>(*this->running)] <=
+            std::chrono::milliseconds{}) {
+        this->fallen = this->running;
+        this->running.reset();
+        this->timer->stop();
+
+        if (this->handler)
+            this->handler(*this->fallen);
+    }
+
+    this->showTime();
+}
+
+void ChessClock::showTime() {
+    auto const side = [this](Colour const colour) -> std::string {
+        std::string const time = format_time(
+            this->times[static_cast<std::size_t>(colour)]
+        );
+
+        return this->running == colour ? std::format("[{}]", time)
+                                       : std::format(" {} ", time);
+    };
+
+    this->setText(
+        QString::fromStdString(
+            std::format("{} | {}", side(Colour::white), side(Colour::black))
+        )
+    );
+}
@@ -0,0 +1,57 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include "../colour.h"
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <optional>
+
+#include <qlabel.h>
+
+class QTimer;
+
+class ChessClock final : public QLabel {
+  public:
+    explicit ChessClock(QWidget *parent = nullptr);
+
+    void reset(
+        std::chrono::milliseconds base, std::chrono::milliseconds increment
+    );
+
+    void press(Colour colour);
+
+    void run(Colour colour);
+
+    void stop();
+
+    [[nodiscard]] auto remaining(Colour colour) const
+        -> std::chrono::milliseconds;
+
+    [[nodiscard]] auto increment() const -> std::chrono::milliseconds;
+
+    [[nodiscard]] auto flagged() const -> std::optional<Colour>;
+
+    void setFlagHandler(std::function<void(Colour)> handler);
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    QTimer *timer = nullptr;
+
+    std::array<std::chrono::milliseconds, 2> times{};
+    std::chrono::milliseconds bonus{};
+    std::optional<Colour> running;
+    std::optional<Colour> fallen;
+    Clock::time_point since;
+    std::function<void(Colour)> handler;
+
+    void charge();
+
+    void tick();
+
+    void showTime();
+};
+
+#endif // CLOCK_H
@@ -0,0 +1,74 @@
+#include "openings.h"
+
+#include "../board/board.h"
+#include "../vars.h"
+
+#include <algorithm>
+#include <format>
+#include <ranges>
+#include <vector>
+
+#include <qheaderview.h>
+
+static auto percentage(std::uint32_t const count, std::uint32_t const games)
+    -> QString {
+    return QString::fromStdString(
+        std::format("{:.0f}%", 100.0 * count / std::max(games, 1u))
+    );
+}
+
+OpeningExplorer::OpeningExplorer(QWidget *parent) : QTableWidget(parent) {
+    this->setColumnCount(5);
+    this->setHorizontalHeaderLabels(
+        {"Move", "Games", "White", "Draw", "Black"}
+    );
+    this->horizontalHeader()->setSectionResizeMode(
+        QHeaderView::ResizeMode::Stretch
+    );
+    this->setEditTriggers(NoEditTriggers);
+}
+
+auto OpeningExplorer::openIndex(char const *path) -> bool {
+    this->explorer.reset(Explorer::open(path));
+
+    this->showPosition();
+
+    return this->explorer != nullptr;
+}
+
+void OpeningExplorer::showPosition() {
+    this->setRowCount(0);
+
+    if (!this->explorer)
+        return;
+
+    std::vector<ExplorerEntry> entries =
+        this->explorer->lookup(k_hash) | std::ranges::to<std::vector>();
+
+    std::ranges::sort(entries, std::ranges::greater{}, &ExplorerEntry::games);
+
+    for (ExplorerEntry const &entry : entries) {
+        std::int32_t const row = this->rowCount();
+
+        this->insertRow(row);
+
+        this->setItem(
+            row, 0,
+            new QTableWidgetItem(
+                QString::fromStdString(to_uci(entry.move.decode()))
+            )
+        );
+        this->setItem(
+            row, 1, new QTableWidgetItem(QString::number(entry.games))
+        );
+        this->setItem(
+            row, 2, new QTableWidgetItem(percentage(entry.white, entry.games))
+        );
+        this->setItem(
+            row, 3, new QTableWidgetItem(percentage(entry.draws, entry.games))
+        );
+        this->setItem(
+            row, 4, new QTableWidgetItem(percentage(entry.black, entry.games))
+        );
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef OPENINGS_H
+#define OPENINGS_H
+
+#include "../explorer/explorer.h"
+
+#include <memory>
+
+#include <qtablewidget.h>
+
+class OpeningExplorer final : public QTableWidget {
+  public:
+    explicit OpeningExplorer(QWidget *parent = nullptr);
+
+    auto openIndex(char const *path) -> bool;
+
+    void showPosition();
+
+  private:
+    std::unique_ptr<Explorer> explorer;
+};
+
+#endif // OPENINGS_H
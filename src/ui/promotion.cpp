@@ -1,6 +1,6 @@
 #include "promotion.h"
 
-#include "../vars.h"
+#include <array>
 
 #include <qboxlayout.h>
 #include <qdialog.h>
@@ -8,17 +8,14 @@
 #include <qpushbutton.h>
 
 PromotionWindow::PromotionWindow(
-    Colour const colour, Square const &square, QPushButton *button,
-    int const font_size, QWidget *parent
+    Colour const colour, int const font_size, QWidget *parent
 )
-    : QDialog(parent), square(square), colour(colour) {
+    : QDialog(parent) {
     this->setWindowFlags(
         Qt::WindowType::Window | Qt::WindowType::WindowTitleHint |
         Qt::WindowType::CustomizeWindowHint
     );
 
-    this->setAttribute(Qt::WidgetAttribute::WA_DeleteOnClose);
-
     QPushButton *queen, *rook, *bishop, *knight;
 
     if (colour == Colour::black) {
@@ -27,17 +24,17 @@ PromotionWindow::PromotionWindow(
         bishop = new QPushButton("♝", this);
         knight = new QPushButton("♞", this);
 
-        connect(queen, &QPushButton::clicked, [this, button]() -> void {
-            this->promote<Queen>("♛", button);
+        connect(queen, &QPushButton::clicked, [this]() -> void {
+            this->promote(PieceType::queen);
         });
-        connect(rook, &QPushButton::clicked, [this, button]() -> void {
-            this->promote<Rook>("♜", button);
+        connect(rook, &QPushButton::clicked, [this]() -> void {
+            this->promote(PieceType::rook);
         });
-        connect(bishop, &QPushButton::clicked, [this, button]() -> void {
-            this->promote<Bishop>("♝", button);
+        connect(bishop, &QPushButton::clicked, [this]() -> void {
+            this->promote(PieceType::bishop);
         });
-        connect(knight, &QPushButton::clicked, [this, button]() -> void {
-            this->promote<Knight>("♞", button);
+        connect(knight, &QPushButton::clicked, [this]() -> void {
+            this->promote(PieceType::knight);
         });
     } else {
         queen = new QPushButton("♕", this);
@@ -45,17 +42,17 @@ PromotionWindow::PromotionWindow(
         bishop = new QPushButton("♗", this);
         knight = new QPushButton("♘", this);
 
-        connect(queen, &QPushButton::clicked, [this, button]() -> void {
-            this->promote<Queen>("♕", button);
+        connect(queen, &QPushButton::clicked, [this]() -> void {
+            this->promote(PieceType::queen);
         });
-        connect(rook, &QPushButton::clicked, [this, button]() -> void {
-            this->promote<Rook>("♖", button);
+        connect(rook, &QPushButton::clicked, [this]() -> void {
+            this->promote(PieceType::rook);
         });
-        connect(bishop, &QPushButton::clicked, [this, button]() -> void {
-            this->promote<Bishop>("♗", button);
+        connect(bishop, &QPushButton::clicked, [this]() -> void {
+            this->promote(PieceType::bishop);
         });
-        connect(knight, &QPushButton::clicked, [this, button]() -> void {
-            this->promote<Knight>("♘", button);
+        connect(knight, &QPushButton::clicked, [this]() -> void {
+            this->promote(PieceType::knight);
         });
     }
 
@@ -71,14 +68,12 @@ PromotionWindow::PromotionWindow(
     }
 }
 
-template <typename Piece>
-    requires std::is_base_of_v<::Piece, Piece>
-void PromotionWindow::promote(QString const &text, QPushButton *button) {
-    delete k_pieces[this->square];
-
-    k_pieces[this->square] = new Piece(this->colour);
+auto PromotionWindow::selection() const -> PieceType {
+    return this->piece_type;
+}
 
-    button->setText(text);
+void PromotionWindow::promote(PieceType const type) {
+    this->piece_type = type;
 
     this->close();
 }
\ No newline at end of file
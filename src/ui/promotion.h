@@ -2,25 +2,22 @@
 #define PROMOTION_H
 
 #include "../colour.h"
-#include "../pieces/pieces.h"
-#include "../square.h"
+#include "../piece_type.h"
 
 #include <qdialog.h>
 
 class PromotionWindow final : public QDialog {
   public:
-    PromotionWindow(
-        Colour colour, Square const &square, QPushButton *button, int font_size,
-        QWidget *parent
-    );
+    PromotionWindow(Colour colour, int font_size, QWidget *parent);
+
+    [[nodiscard]] auto selection() const -> PieceType;
 
   private:
-    Square const &square;
-    Colour const colour;
+    friend class ReplayHarness;
+
+    PieceType piece_type = PieceType::queen;
 
-    template <typename Piece>
-        requires std::is_base_of_v<::Piece, Piece>
-    void promote(QString const &text, QPushButton *button);
+    void promote(PieceType type);
 };
 
 #endif // PROMOTION_H
@@ -140,11 +140,55 @@ void MoveRecord::addMove(
     this->setItem(this->rowCount() - 1, column, new QTableWidgetItem(text));
 }
 
-void MoveRecord::clearRecords() { this->setRowCount(0); }
+void MoveRecord::clearRecords(Colour const first) {
+    this->setRowCount(0);
+
+    this->count = 0;
+    this->offset = first == Colour::white ? 0 : 1;
+}
+
+void MoveRecord::truncate(std::size_t const plies) {
+    if (plies >= this->count)
+        return;
+
+    std::size_t const cells = plies + this->offset;
+
+    this->setRowCount(plies ? static_cast<std::int32_t>((cells + 1) / 2) : 0);
+
+    if (plies && cells % 2)
+        delete this->takeItem(this->rowCount() - 1, 1);
+
+    this->count = plies;
+}
+
+auto MoveRecord::plies() const -> std::size_t { return this->count; }
+
+void MoveRecord::setCurrentPly(std::size_t const ply) {
+    if (!ply) {
+        this->clearSelection();
+
+        return;
+    }
+
+    std::size_t const cell = ply - 1 + this->offset;
+
+    this->setCurrentCell(
+        static_cast<std::int32_t>(cell / 2), static_cast<std::int32_t>(cell % 2)
+    );
+}
+
+auto MoveRecord::plyAt(std::int32_t const row, std::int32_t const column) const
+    -> std::size_t {
+    std::size_t const cell = static_cast<std::size_t>(row * 2 + column);
+
+    return cell < this->offset ? 0 : cell + 1 - this->offset;
+}
 
 void MoveRecord::addMoveBase(Colour const colour) {
-    if (colour == Colour::black)
+    ++this->count;
+
+    if (colour == Colour::black && this->rowCount())
         return;
 
     this->insertRow(this->rowCount());
-}
\ No newline at end of file
+}
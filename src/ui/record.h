@@ -23,9 +23,21 @@ class MoveRecord final : public QTableWidget {
         bool take
     );
 
-    void clearRecords();
+    void clearRecords(Colour first = Colour::white);
+
+    void truncate(std::size_t plies);
+
+    [[nodiscard]] auto plies() const -> std::size_t;
+
+    void setCurrentPly(std::size_t ply);
+
+    [[nodiscard]] auto plyAt(std::int32_t row, std::int32_t column) const
+        -> std::size_t;
 
   private:
+    std::size_t count = 0;
+    std::size_t offset = 0;
+
     void addMoveBase(Colour colour);
 };
 
@@ -0,0 +1,221 @@
+#include "replay.h"
+
+#include "clock.h"
+#include "promotion.h"
+#include "window.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <ranges>
+#include <utility>
+
+#include <qevent.h>
+#include <qpushbutton.h>
+#include <qtest.h>
+#include <qtimer.h>
+
+static std::chrono::milliseconds constexpr k_paint_timeout =
+    std::chrono::seconds(1);
+
+static auto parse_square(std::string_view const token)
+    -> std::optional<Square> {
+    if (token.size() != 2 || token[0] < 'a' || token[0] > 'h' ||
+        token[1] < '1' || token[1] > '8')
+        return std::nullopt;
+
+    return Square('8' - token[1], token[0] - 'a');
+}
+
+static auto parse_promotion(char const letter) -> std::optional<PieceType> {
+    switch (letter) {
+    case 'q':
+        return PieceType::queen;
+    case 'r':
+        return PieceType::rook;
+    case 'b':
+        return PieceType::bishop;
+    case 'n':
+        return PieceType::knight;
+    default:
+        return std::nullopt;
+    }
+}
+
+auto parse_script(std::string_view const text) -> std::optional<Script> {
+    Script script;
+
+    for (auto const line : std::views::split(text, '\n')) {
+        std::string_view const view(line.begin(), line.end());
+
+        if (view.starts_with('#'))
+            continue;
+
+        std::vector<Click> clicks;
+
+        for (auto const word : std::views::split(view, ' ')) {
+            std::string_view const token(word.begin(), word.end());
+
+            if (token.empty())
+                continue;
+
+            std::optional<Square> const start =
+                parse_square(token.substr(0, 2));
+            std::optional<Square> const end =
+                token.size() >= 4 ? parse_square(token.substr(2, 2))
+                                  : std::nullopt;
+            std::optional<PieceType> const promotion =
+                token.size() == 5 ? parse_promotion(token[4])
+                                  : PieceType::queen;
+
+            if (!start || (token.size() != 2 && !end) || !promotion ||
+                token.size() > 5)
+                return std::nullopt;
+
+            clicks.push_back({.square = *start});
+
+            if (end)
+                clicks.push_back({.square = *end, .promotion = *promotion});
+        }
+
+        if (!clicks.empty())
+            script.push_back(std::move(clicks));
+    }
+
+    return script;
+}
+
+auto summarise_latencies(
+    std::vector<std::chrono::nanoseconds> samples, std::size_t const dropped
+) -> Latencies {
+    std::ranges::sort(samples);
+
+    auto const percentile = [&samples](double const fraction) -> double {
+        if (samples.empty())
+            return 0;
+
+        auto const index = static_cast<std::size_t>(
+            std::ceil(fraction * static_cast<double>(samples.size())) - 1
+        );
+
+        return std::chrono::duration<double, std::milli>(
+                   samples[std::min(index, samples.size() - 1)]
+        )
+            .count();
+    };
+
+    return {
+        .actions = samples.size(),
+        .dropped = dropped,
+        .p50 = percentile(0.5),
+        .p95 = percentile(0.95),
+        .p99 = percentile(0.99),
+        .max = percentile(1),
+    };
+}
+
+ReplayHarness::ReplayHarness(MainWindow &window) : window(window) {
+    QApplication::instance()->installEventFilter(this);
+}
+
+ReplayHarness::~ReplayHarness() {
+    QApplication::instance()->removeEventFilter(this);
+}
+
+auto ReplayHarness::play(
+    std::vector<Click> const &clicks,
+    std::vector<std::chrono::nanoseconds> &samples
+) -> Latencies {
+    this->window.newGame();
+
+    std::vector<std::chrono::nanoseconds> game;
+    std::size_t dropped = 0;
+
+    for (Click const &click : clicks)
+        if (std::optional<std::chrono::nanoseconds> const latency =
+                this->click(click))
+            game.push_back(*latency);
+        else
+            ++dropped;
+
+    samples.insert(samples.end(), game.begin(), game.end());
+
+    return summarise_latencies(std::move(game), dropped);
+}
+
+auto ReplayHarness::eventFilter(QObject *watched, QEvent *event) -> bool {
+    if (event->type() == QEvent::Type::Paint &&
+        std::ranges::find(this->window.buttons, watched) !=
+            this->window.buttons.end())
+        this->painted.push_back(watched);
+
+    return false;
+}
+
+auto ReplayHarness::click(Click const &click)
+    -> std::optional<std::chrono::nanoseconds> {
+    QPushButton *button = this->window.buttons[click.square];
+
+    if (!button->isEnabled())
+        return std::nullopt;
+
+    this->window.clock->stop();
+
+    QApplication::processEvents();
+
+    QTimer::singleShot(0, this, [promotion = click.promotion]() -> void {
+        QWidget *modal = QApplication::activeModalWidget();
+
+        if (auto *dialog = dynamic_cast<PromotionWindow *>(modal))
+            dialog->promote(promotion);
+        else if (modal)
+            modal->close();
+    });
+
+    auto const snapshot = [this]() -> std::array<std::pair<QString, bool>, 64> {
+        std::array<std::pair<QString, bool>, 64> squares;
+
+        for (std::size_t i = 0; i < squares.size(); ++i)
+            squares[i] = {
+                this->window.buttons[i]->text(),
+                this->window.buttons[i]->isEnabled()
+            };
+
+        return squares;
+    };
+
+    std::array<std::pair<QString, bool>, 64> const before = snapshot();
+
+    this->painted.clear();
+
+    auto const start = std::chrono::steady_clock::now();
+
+    QTest::mouseClick(button, Qt::MouseButton::LeftButton);
+
+    std::array<std::pair<QString, bool>, 64> const after = snapshot();
+    std::vector<QObject const *> changed;
+
+    for (std::size_t i = 0; i < after.size(); ++i)
+        if (before[i] != after[i])
+            changed.push_back(this->window.buttons[i]);
+
+    auto const updated = [this, &changed]() -> bool {
+        return std::ranges::any_of(
+            changed, [this](QObject const *widget) -> bool {
+                return std::ranges::find(this->painted, widget) !=
+                       this->painted.end();
+            }
+        );
+    };
+
+    while (!changed.empty() && !updated() &&
+           std::chrono::steady_clock::now() - start < k_paint_timeout)
+        QApplication::processEvents();
+
+    auto const end = std::chrono::steady_clock::now();
+
+    if (!updated())
+        return std::nullopt;
+
+    return end - start;
+}
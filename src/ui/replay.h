@@ -0,0 +1,65 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "../piece_type.h"
+#include "../square.h"
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <qobject.h>
+
+class MainWindow;
+class QEvent;
+
+struct Click final {
+    Square square;
+    PieceType promotion = PieceType::queen;
+};
+
+using Script = std::vector<std::vector<Click>>;
+
+struct Latencies final {
+    std::size_t actions = 0;
+    std::size_t dropped = 0;
+    double p50 = 0;
+    double p95 = 0;
+    double p99 = 0;
+    double max = 0;
+};
+
+[[nodiscard]] auto parse_script(std::string_view text) -> std::optional<Script>;
+
+[[nodiscard]] auto summarise_latencies(
+    std::vector<std::chrono::nanoseconds> samples, std::size_t dropped
+) -> Latencies;
+
+class ReplayHarness final : public QObject {
+  public:
+    explicit ReplayHarness(MainWindow &window);
+
+    ReplayHarness(ReplayHarness const &) = delete;
+
+    auto operator=(ReplayHarness const &) -> ReplayHarness & = delete;
+
+    ~ReplayHarness() override;
+
+    [[nodiscard]] auto play(
+        std::vector<Click> const &clicks,
+        std::vector<std::chrono::nanoseconds> &samples
+    ) -> Latencies;
+
+    auto eventFilter(QObject *watched, QEvent *event) -> bool override;
+
+  private:
+    MainWindow &window;
+    std::vector<QObject const *> painted;
+
+    [[nodiscard]] auto click(Click const &click)
+        -> std::optional<std::chrono::nanoseconds>;
+};
+
+#endif // REPLAY_H
@@ -1,35 +1,91 @@
 #include "window.h"
 
+#include "../archive/archive.h"
+#include "../board/board.h"
 #include "../move/move.h"
+#include "../nnue/nnue.h"
 #include "../pieces/pieces.h"
+#include "../search/see.h"
+#include "../solver/solver.h"
+#include "../stats/trace.h"
 #include "../vars.h"
+#include "clock.h"
+#include "openings.h"
 #include "promotion.h"
 #include "record.h"
 
+#include <array>
+#include <chrono>
+#include <format>
+#include <memory>
+#include <random>
 #include <ranges>
+#include <thread>
 
 #include <qboxlayout.h>
+#include <qevent.h>
+#include <qfiledialog.h>
 #include <qgridlayout.h>
+#include <qinputdialog.h>
 #include <qlabel.h>
+#include <qmetaobject.h>
 #include <qpushbutton.h>
+#include <qtimer.h>
+
+static std::array<std::array<char const *, 6>, 2> constexpr k_symbols{
+    std::array{"♙", "♘", "♗", "♖", "♕", "♔"},
+    std::array{"♟︎", "♞", "♝", "♜", "♛", "♚"},
+};
+
+static std::chrono::milliseconds constexpr k_base_time =
+    std::chrono::minutes(5);
+static std::chrono::milliseconds constexpr k_increment =
+    std::chrono::seconds(3);
+
+static std::int32_t constexpr k_default_mate = 3;
+static std::int32_t constexpr k_max_mate = 12;
+static std::size_t constexpr k_solver_memory = std::size_t{64} << 20;
+
+struct Level final {
+    std::int32_t depth;
+    std::uint64_t nodes;
+    std::int32_t blunders;
+};
+
+static std::array<Level, 8> constexpr k_levels{{
+    {1, 100, 40},
+    {2, 500, 25},
+    {3, 2000, 15},
+    {4, 8000, 8},
+    {5, 30000, 3},
+    {6, 100000, 0},
+    {8, 400000, 0},
+    {k_max_ply - 1, 0, 0},
+}};
+
+static std::int32_t constexpr k_max_latency = 60000;
 
 MainWindow::MainWindow(QWidget *parent) : QDialog(parent) {
-    this->buttons =
-        k_board | std::views::join |
-        std::views::transform(
-            [](Square const &square) -> std::pair<Square, QPushButton *> {
-                return {square, new QPushButton};
-            }
-        ) |
-        std::ranges::to<std::map>();
-
     this->player = new QLabel("White to play", this);
 
+    this->clock = new ChessClock(this);
+    this->clock->setFlagHandler([this](Colour) -> void {
+        this->showPosition();
+    });
+
+    auto *header = new QHBoxLayout;
+    header->addWidget(this->player);
+    header->addWidget(this->clock);
+
     auto *board = new QGridLayout;
     board->setHorizontalSpacing(0);
     board->setVerticalSpacing(0);
 
-    for (auto const &[square, button] : this->buttons) {
+    for (Square const square : k_squares) {
+        auto *button = new QPushButton;
+
+        this->buttons[square] = button;
+
         button->setMaximumSize(this->k_font_size, this->k_font_size);
         button->setMinimumSize(this->k_font_size, this->k_font_size);
 
@@ -37,9 +93,7 @@ MainWindow::MainWindow(QWidget *parent) : QDialog(parent) {
             this->selectPiece(square);
         });
 
-        auto const &[rank, file] = square;
-
-        if (rank % 2 != file % 2) {
+        if (square.rank() % 2 != square.file() % 2) {
             button->setStyleSheet(
                 "QPushButton {"
                 "   background-color : #101010;"
@@ -69,11 +123,9 @@ MainWindow::MainWindow(QWidget *parent) : QDialog(parent) {
             );
         }
 
-        board->addWidget(button, rank, file);
+        board->addWidget(button, square.rank(), square.file());
     }
 
-    this->setBoard();
-
     auto *markings = new QGridLayout;
 
     markings->addWidget(new QLabel("a"), 0, 1, Qt::AlignmentFlag::AlignCenter);
@@ -120,70 +172,136 @@ MainWindow::MainWindow(QWidget *parent) : QDialog(parent) {
     });
 
     this->record = new MoveRecord(this);
+    connect(
+        this->record, &MoveRecord::cellClicked,
+        [this](std::int32_t const row, std::int32_t const column) -> void {
+            this->jumpTo(this->record->plyAt(row, column));
+        }
+    );
+
+    auto *undo = new QPushButton("Undo", this);
+    connect(undo, &QPushButton::clicked, [this]() -> void {
+        this->undoMove();
+    });
+
+    auto *redo = new QPushButton("Redo", this);
+    connect(redo, &QPushButton::clicked, [this]() -> void {
+        this->redoMove();
+    });
+
+    this->explorer = new OpeningExplorer(this);
+
+    auto *openIndex = new QPushButton("Open Index", this);
+    connect(openIndex, &QPushButton::clicked, [this]() -> void {
+        this->openIndex();
+    });
+
+    auto *network = new QPushButton("Network", this);
+    connect(network, &QPushButton::clicked, [this]() -> void {
+        this->loadNetwork();
+    });
+
+    auto *save = new QPushButton("Save", this);
+    connect(save, &QPushButton::clicked, [this]() -> void {
+        this->saveGame();
+    });
+
+    auto *load = new QPushButton("Load", this);
+    connect(load, &QPushButton::clicked, [this]() -> void {
+        this->loadGame();
+    });
+
+    this->solveButton = new QPushButton("Solve", this);
+    connect(this->solveButton, &QPushButton::clicked, [this]() -> void {
+        this->solvePuzzle();
+    });
+
+    auto *opponent = new QPushButton("Computer", this);
+    connect(opponent, &QPushButton::clicked, [this]() -> void {
+        this->chooseOpponent();
+    });
+
+    auto *controls = new QHBoxLayout;
+    controls->addWidget(newGame);
+    controls->addWidget(undo);
+    controls->addWidget(redo);
+    controls->addWidget(save);
+    controls->addWidget(load);
+    controls->addWidget(this->solveButton);
+    controls->addWidget(opponent);
+    controls->addWidget(network);
+
+    this->stats = new QLabel(this);
+    this->stats->setStyleSheet(
+        "QLabel {"
+        "   background-color : rgba(0, 0, 0, 192);"
+        "   color : #E0E0E0;"
+        "   font-family : monospace;"
+        "   padding : 8px;"
+        "}"
+    );
+    this->stats->setAttribute(
+        Qt::WidgetAttribute::WA_TransparentForMouseEvents
+    );
+    this->stats->hide();
+
+    this->showStats("", {}, {});
+
+    auto *showStats = new QPushButton("Stats", this);
+    showStats->setCheckable(true);
+    connect(
+        showStats, &QPushButton::toggled,
+        [this](bool const checked) -> void {
+            this->stats->setVisible(checked);
+            this->stats->raise();
+        }
+    );
 
     auto *layout = new QGridLayout(this);
     layout->setSizeConstraint(QGridLayout::SizeConstraint::SetFixedSize);
-    layout->addWidget(this->player, 0, 0, Qt::AlignmentFlag::AlignCenter);
+    layout->addLayout(header, 0, 0, Qt::AlignmentFlag::AlignCenter);
     layout->addWidget(
         new QLabel("Moves"), 0, 1, Qt::AlignmentFlag::AlignCenter
     );
     layout->addLayout(markings, 1, 0);
+    layout->addWidget(
+        new QLabel("Explorer"), 0, 2, Qt::AlignmentFlag::AlignCenter
+    );
     layout->addWidget(this->record, 1, 1);
-    layout->addWidget(newGame, 2, 0);
+    layout->addWidget(this->explorer, 1, 2);
+    layout->addLayout(controls, 2, 0);
+    layout->addWidget(showStats, 2, 1);
+    layout->addWidget(openIndex, 2, 2);
+
+    this->setBoard();
+}
+
+MainWindow::~MainWindow() {
+    this->stopThinking();
+    this->joinSolver();
+
+    delete k_network;
+    k_network = nullptr;
 }
 
 void MainWindow::setBoard() {
-    for (Piece const *piece : k_pieces | std::views::values)
-        delete piece;
-
-    k_pieces[k_board[0][0]] = new Rook(Colour::black);
-    k_pieces[k_board[0][1]] = new Knight(Colour::black);
-    k_pieces[k_board[0][2]] = new Bishop(Colour::black);
-    k_pieces[k_board[0][3]] = new Queen(Colour::black);
-    k_pieces[k_board[0][4]] = new King(Colour::black);
-    k_pieces[k_board[0][5]] = new Bishop(Colour::black);
-    k_pieces[k_board[0][6]] = new Knight(Colour::black);
-    k_pieces[k_board[0][7]] = new Rook(Colour::black);
-
-    for (std::size_t index = 0; index < 8; ++index) {
-        k_pieces[k_board[1][index]] = new Pawn(Colour::black);
-        k_pieces[k_board[6][index]] = new Pawn(Colour::white);
-
-        this->buttons[k_board[1][index]]->setText("♟︎");
-        this->buttons[k_board[6][index]]->setText("♙");
-    }
+    (void)this->game.reset(k_start_fen);
 
-    k_pieces[k_board[7][0]] = new Rook(Colour::white);
-    k_pieces[k_board[7][1]] = new Knight(Colour::white);
-    k_pieces[k_board[7][2]] = new Bishop(Colour::white);
-    k_pieces[k_board[7][3]] = new Queen(Colour::white);
-    k_pieces[k_board[7][4]] = new King(Colour::white);
-    k_pieces[k_board[7][5]] = new Bishop(Colour::white);
-    k_pieces[k_board[7][6]] = new Knight(Colour::white);
-    k_pieces[k_board[7][7]] = new Rook(Colour::white);
-
-    this->buttons[k_board[0][0]]->setText("♜");
-    this->buttons[k_board[0][1]]->setText("♞");
-    this->buttons[k_board[0][2]]->setText("♝");
-    this->buttons[k_board[0][3]]->setText("♛");
-    this->buttons[k_board[0][4]]->setText("♚");
-    this->buttons[k_board[0][5]]->setText("♝");
-    this->buttons[k_board[0][6]]->setText("♞");
-    this->buttons[k_board[0][7]]->setText("♜");
-
-    this->buttons[k_board[7][0]]->setText("♖");
-    this->buttons[k_board[7][1]]->setText("♘");
-    this->buttons[k_board[7][2]]->setText("♗");
-    this->buttons[k_board[7][3]]->setText("♕");
-    this->buttons[k_board[7][4]]->setText("♔");
-    this->buttons[k_board[7][5]]->setText("♗");
-    this->buttons[k_board[7][6]]->setText("♘");
-    this->buttons[k_board[7][7]]->setText("♖");
-
-    for (auto const &[square, piece] : k_pieces)
-        this->buttons[square]->setEnabled(
-            piece && piece->colour == k_current_player
+    this->clock->reset(k_base_time, k_increment);
+
+    this->showPosition();
+}
+
+void MainWindow::drawBoard() {
+    for (Square const square : k_squares) {
+        Piece const *piece = k_pieces[square];
+
+        this->buttons[square]->setText(
+            piece ? k_symbols[static_cast<std::size_t>(piece->colour)]
+                             [static_cast<std::size_t>(piece->type())]
+                  : ""
         );
+    }
 }
 
 void MainWindow::selectPiece(Square const &square) {
@@ -195,14 +313,11 @@ void MainWindow::selectPiece(Square const &square) {
 
     if (this->currentSquare != square)
         this->makeMove(square);
+    else
+        this->showPosition();
 
     this->currentSquare = {0, 0};
     this->selectedPiece = nullptr;
-
-    for (auto const &[square, piece] : k_pieces)
-        this->buttons[square]->setEnabled(
-            piece && piece->colour == k_current_player
-        );
 }
 
 void MainWindow::prepareMove(Square const square) {
@@ -215,208 +330,374 @@ void MainWindow::prepareMove(Square const square) {
 
     std::set<Move> const &moves = this->selectedPiece->get_moves(square);
 
-    for (QPushButton *button : this->buttons | std::views::values)
+    for (QPushButton *button : this->buttons)
         button->setEnabled(false);
 
-    for (auto const &[start, end] : moves)
-        this->buttons[end]->setEnabled(true);
+    for (Move const &move : moves)
+        this->buttons[move.end]->setEnabled(true);
 
     this->buttons[square]->setEnabled(true);
 }
 
-void MainWindow::makeMove(Square square) {
-    auto const [rank, file] = square;
-    bool take = false;
+void MainWindow::makeMove(Square const square) {
+    TraceSpan const span("makeMove");
+
+    Colour const colour = this->selectedPiece->colour;
+    Move move{this->currentSquare, square};
+
+    if (is_promotion(move)) {
+        TraceSpan const dialog("makeMove/promotion");
+
+        PromotionWindow promotion_window(colour, this->k_font_size, this);
+
+        promotion_window.exec();
+
+        move.promotion = promotion_window.selection();
+    }
+
+    this->playMove(move);
+}
+
+void MainWindow::playMove(Move const &move) {
+    Colour const colour = k_pieces[move.start]->colour;
+    std::string const name = to_uci(move);
 
-    Square const &new_pos =
-        k_board[this->currentSquare.rank][this->currentSquare.file];
-    std::swap(k_pieces[square], k_pieces[new_pos]);
+    Counters const before = counters();
+    auto const start = std::chrono::steady_clock::now();
 
-    QPushButton *nextButton = this->buttons[k_board[rank][file]];
-    QPushButton *currentButton = this->buttons[new_pos];
+    PackedMove const packed = PackedMove::encode(move);
 
-    QString text = nextButton->text();
+    {
+        TraceSpan const play("makeMove/play");
 
-    if (!text.isEmpty()) {
-        text = "";
+        this->game.play(move);
+        this->clock->press(colour);
+    }
 
-        delete k_pieces[new_pos];
-        k_pieces[new_pos] = nullptr;
+    {
+        TraceSpan const update("makeMove/record");
 
-        take = true;
+        this->record->truncate(this->game.ply() - 1);
+        this->recordMove(packed);
     }
 
-    nextButton->setText(currentButton->text());
-    currentButton->setText(text);
+    this->showPosition();
 
-    Colour const colour = this->selectedPiece->colour;
+    auto const elapsed = std::chrono::steady_clock::now() - start;
+
+    Counters delta = counters();
+
+    for (std::size_t i = 0; i < k_counter_count; ++i)
+        delta[i] -= before[i];
 
-    if (k_current_player == Colour::white) {
-        k_current_player = Colour::black;
-        this->player->setText("Black to play");
-    } else {
-        k_current_player = Colour::white;
-        this->player->setText("White to play");
+    record_sample(name, delta, elapsed);
+
+    this->showStats(name, delta, elapsed);
+}
+
+void MainWindow::recordMove(PackedMove const packed) {
+    Move const move = packed.decode();
+    Colour const colour =
+        k_current_player == Colour::white ? Colour::black : Colour::white;
+
+    bool const check = in_check();
+    bool const checkmate = check && !has_legal_moves();
+
+    std::string t;
+
+    if (Piece const *piece = k_pieces[move.end];
+        typeid(*piece) == typeid(Pawn))
+        t = "";
+    else if (typeid(*piece) == typeid(Knight))
+        t = "N";
+    else if (typeid(*piece) == typeid(Bishop))
+        t = "B";
+    else if (typeid(*piece) == typeid(Rook))
+        t = "R";
+    else if (typeid(*piece) == typeid(Queen))
+        t = "Q";
+    else if (typeid(*piece) == typeid(King))
+        t = "K";
+
+    if (packed.is_castle())
+        this->record->addCastle(
+            colour, packed.flags() == PackedMove::queen_castle
+        );
+    else if (packed.is_promotion())
+        this->record->addPromotion(
+            colour, move, t, checkmate, check, packed.is_capture()
+        );
+    else
+        this->record->addMove(
+            colour, move, t, check, checkmate, packed.is_capture()
+        );
+}
+
+void MainWindow::showPosition() {
+    TraceSpan const span("showPosition");
+
+    this->stopThinking();
+
+    this->drawBoard();
+
+    this->record->setCurrentPly(this->game.ply());
+    this->explorer->showPosition();
+
+    std::optional<Colour> const flagged = this->clock->flagged();
+    bool const flag = !flagged && has_legal_moves();
+
+    if (flagged)
+        this->player->setText(
+            std::format(
+                "{} loses on time",
+                *flagged == Colour::white ? "White" : "Black"
+            )
+                .c_str()
+        );
+    else if (flag)
+        this->player->setText(
+            k_current_player == Colour::white ? "White to play"
+                                              : "Black to play"
+        );
+    else if (in_check())
+        this->player->setText(
+            std::format(
+                "Checkmate! {} wins!",
+                k_current_player == Colour::black ? "White" : "Black"
+            )
+                .c_str()
+        );
+    else
+        this->player->setText("Stalemate");
+
+    if (flag && this->game.ply())
+        this->clock->run(k_current_player);
+    else
+        this->clock->stop();
+
+    bool const thinking = flag && this->computer == k_current_player;
+
+    for (Square const square : k_squares) {
+        Piece const *piece = k_pieces[square];
+
+        this->buttons[square]->setEnabled(
+            flag && !thinking && piece && piece->colour == k_current_player
+        );
     }
 
-    bool const check =
-        dynamic_cast<King *>(k_pieces[k_king_pos[k_current_player]])
-            ->is_checked();
+    if (thinking)
+        this->think();
+}
 
-    for (Piece *piece : k_pieces | std::views::values)
-        if (auto *pawn = dynamic_cast<Pawn *>(piece);
-            pawn && pawn->colour == colour)
-            pawn->can_be_en_passanted = false;
+void MainWindow::undoMove() {
+    this->currentSquare = {0, 0};
+    this->selectedPiece = nullptr;
 
-    bool promote = false, castle = false;
+    if (this->game.undo())
+        this->showPosition();
+}
 
-    if (auto *pawn = dynamic_cast<Pawn *>(this->selectedPiece); pawn) {
-        pawn->moved = true;
+void MainWindow::redoMove() {
+    this->currentSquare = {0, 0};
+    this->selectedPiece = nullptr;
 
-        if (std::int32_t const rank_diff = rank - this->currentSquare.rank;
-            rank_diff == -2 || rank_diff == 2) {
-            pawn->can_be_en_passanted = true;
-        } else if ((colour == Colour::white && rank == 0) ||
-                   (colour == Colour::black && rank == 7)) {
-            PromotionWindow promotion_window(
-                colour, square, this->buttons[square], this->k_font_size, this
-            );
+    if (!this->game.redo())
+        return;
 
-            promotion_window.exec();
+    if (this->record->plies() < this->game.ply())
+        this->recordMove(
+            this->game.node(this->game.line()[this->game.ply()]).move
+        );
 
-            promote = true;
-        } else if ((this->currentSquare.file > 0 &&
-                    file == this->currentSquare.file - 1) ||
-                   (this->currentSquare.file < 7 &&
-                    file == this->currentSquare.file - 1)) {
-            auto *pawn = dynamic_cast<Pawn *>(
-                k_pieces[k_board[this->currentSquare.rank][file]]
-            );
+    this->showPosition();
+}
 
-            if (pawn && pawn->colour != this->selectedPiece->colour &&
-                pawn->can_be_en_passanted) {
-                delete k_pieces[k_board[this->currentSquare.rank][file]];
-                k_pieces[k_board[this->currentSquare.rank][file]] = nullptr;
+void MainWindow::jumpTo(std::size_t const ply) {
+    this->currentSquare = {0, 0};
+    this->selectedPiece = nullptr;
 
-                this->buttons[k_board[this->currentSquare.rank][file]]->setText(
-                    ""
-                );
-            }
-        }
-    } else if (auto *king = dynamic_cast<King *>(this->selectedPiece)) {
-        k_king_pos[colour] = k_board[rank][file];
+    this->game.jump(ply);
+
+    this->showPosition();
+}
 
-        king->moved = true;
+void MainWindow::saveGame() {
+    QString const path = QFileDialog::getSaveFileName(
+        this, "Save Game", "", "Game archives (*.chsa)"
+    );
 
-        for (Piece *piece : k_pieces | std::views::values)
-            if (auto *rook = dynamic_cast<Rook *>(piece);
-                rook && rook->colour == colour)
-                rook->can_castle = false;
+    if (path.isEmpty())
+        return;
 
-        if (std::int32_t const file_diff = file - this->currentSquare.file;
-            file_diff == -2 || file_diff == 2) {
-            Rank const rank_ = colour == Colour::white ? 7 : 0;
+    ArchivedGame game;
 
-            Square start, end;
+    if (this->game.root() != k_start_fen)
+        game.tags.emplace_back("FEN", this->game.root());
 
-            bool long_castle;
+    for (std::uint32_t const node : this->game.line() | std::views::drop(1))
+        game.moves.push_back(this->game.node(node).move);
 
-            if (file == 2) {
-                start = k_board[rank_][0];
-                end = k_board[rank][3];
-                long_castle = true;
-            } else {
-                start = k_board[rank_][7];
-                end = k_board[rank_][5];
-                long_castle = false;
-            }
+    std::unique_ptr<ArchiveWriter> const writer(
+        ArchiveWriter::open(path.toStdString().c_str())
+    );
 
-            std::swap(k_pieces[start], k_pieces[end]);
+    if (!writer || !writer->append(game) || !writer->finish())
+        this->player->setText("Failed to save the game");
+}
 
-            this->buttons[end]->setText(this->buttons[start]->text());
-            this->buttons[start]->setText("");
+void MainWindow::loadGame() {
+    QString const path = QFileDialog::getOpenFileName(
+        this, "Load Game", "", "Game archives (*.chsa)"
+    );
 
-            this->record->addCastle(colour, long_castle);
+    if (path.isEmpty())
+        return;
 
-            castle = true;
-        }
-    } else if (auto *rook = dynamic_cast<Rook *>(this->selectedPiece)) {
-        rook->can_castle = false;
+    std::unique_ptr<ArchiveReader> const reader(
+        ArchiveReader::open(path.toStdString().c_str())
+    );
+
+    if (!reader || !reader->size()) {
+        this->player->setText("Failed to load the game");
+
+        return;
     }
 
-    bool flag = false;
+    auto const size = static_cast<std::int32_t>(reader->size());
 
-    for (auto const &[square, piece] : k_pieces) {
-        if (!piece || piece->colour != k_current_player ||
-            piece->get_moves(square).empty())
-            continue;
+    bool accepted = false;
 
-        flag = true;
+    std::int32_t const number = QInputDialog::getInt(
+        this, "Load Game", "Game number", size, 1, size, 1, &accepted
+    );
 
-        break;
+    if (!accepted)
+        return;
+
+    std::optional<ArchivedGame> const game =
+        reader->game(static_cast<std::size_t>(number - 1));
+
+    if (!game) {
+        this->player->setText("Failed to load the game");
+
+        return;
     }
 
-    bool checkmate = false;
+    this->currentSquare = {0, 0};
+    this->selectedPiece = nullptr;
 
-    if (!flag) {
-        if (check) {
-            this->player->setText(
-                std::format(
-                    "Checkmate! {} wins!",
-                    k_current_player == Colour::black ? "White" : "Black"
-                )
-                    .c_str()
-            );
+    std::string_view const fen = game->tag("FEN");
 
-            checkmate = true;
-        } else {
-            this->player->setText("Stalemate");
-        }
+    (void)this->game.reset(fen.empty() ? k_start_fen : fen);
+
+    this->record->clearRecords(k_current_player);
 
-        for (QPushButton *button : this->buttons | std::views::values)
-            button->setEnabled(false);
+    this->clock->reset(k_base_time, k_increment);
+
+    for (PackedMove const move : game->moves) {
+        this->game.play(move.decode());
+        this->recordMove(move);
     }
 
-    std::string t;
+    this->showPosition();
+}
 
-    if (Piece const *piece = k_pieces[square]; typeid(*piece) == typeid(Pawn))
-        t = "";
-    else if (typeid(*piece) == typeid(Knight))
-        t = "N";
-    else if (typeid(*piece) == typeid(Bishop))
-        t = "B";
-    else if (typeid(*piece) == typeid(Rook))
-        t = "R";
-    else if (typeid(*piece) == typeid(Queen))
-        t = "Q";
-    else if (typeid(*piece) == typeid(King))
-        t = "K";
+void MainWindow::openIndex() {
+    QString const path = QFileDialog::getOpenFileName(
+        this, "Open Index", "", "Position indices (*.chsx)"
+    );
 
-    if (promote)
-        this->record->addPromotion(
-            colour, {this->currentSquare, square}, t, check, checkmate, take
-        );
-    else if (!castle)
-        this->record->addMove(
-            colour, {this->currentSquare, square}, t, check, checkmate, take
-        );
+    if (!path.isEmpty() &&
+        !this->explorer->openIndex(path.toStdString().c_str()))
+        this->player->setText("Failed to open the index");
 }
 
-void MainWindow::newGame() {
-    for (Piece *&piece : k_pieces | std::views::values) {
-        delete piece;
+void MainWindow::loadNetwork() {
+    QString const path = QFileDialog::getOpenFileName(
+        this, "Load Network", "", "Networks (*.bin);;All files (*)"
+    );
+
+    if (path.isEmpty())
+        return;
 
-        piece = nullptr;
+    Network *network = Network::load(path.toStdString().c_str());
+
+    if (!network) {
+        this->player->setText("Failed to load the network");
+
+        return;
     }
 
-    for (QPushButton *button : this->buttons | std::views::values)
-        button->setText("");
+    this->stopThinking();
+    this->joinSolver();
+
+    delete k_network;
+    k_network = network;
+
+    this->showPosition();
+}
+
+void MainWindow::solvePuzzle() {
+    bool accepted = false;
+
+    std::int32_t const moves = QInputDialog::getInt(
+        this, "Solve", "Mate in at most", k_default_mate, 1, k_max_mate, 1,
+        &accepted
+    );
+
+    if (!accepted)
+        return;
+
+    this->joinSolver();
+    this->solveButton->setEnabled(false);
 
-    k_king_pos[Colour::white] = k_board[7][4];
-    k_king_pos[Colour::black] = k_board[0][4];
+    this->solver = std::thread([this, position = fen(), moves]() -> void {
+        (void)load_fen(position);
 
-    k_current_player = Colour::white;
+        MateSolver solver(k_solver_memory, this->stopSolver);
+
+        Solution const solution = solver.solve(moves);
+        std::string text;
+
+        if (solution.verdict == Verdict::mate) {
+            text = std::format("Mate in {}:", solution.moves);
+
+            for (Move const &move : solution.line) {
+                text += ' ' + to_uci(move);
+
+                play(move);
+            }
+        } else if (solution.verdict == Verdict::none) {
+            text = std::format("No mate by checks in {}", moves);
+        } else if (this->stopSolver) {
+            text = "Solver stopped";
+        } else {
+            text = "Out of solver memory";
+        }
+
+        clear_board();
+
+        QMetaObject::invokeMethod(
+            this,
+            [this, text]() -> void {
+                this->player->setText(QString::fromStdString(text));
+                this->solveButton->setEnabled(true);
+            },
+            Qt::ConnectionType::QueuedConnection
+        );
+    });
+}
+
+void MainWindow::joinSolver() {
+    this->stopSolver = true;
+
+    if (this->solver.joinable())
+        this->solver.join();
+
+    this->stopSolver = false;
+}
 
+void MainWindow::newGame() {
     this->currentSquare = {0, 0};
     this->selectedPiece = nullptr;
 
@@ -425,9 +706,171 @@ void MainWindow::newGame() {
     this->setBoard();
 }
 
+void MainWindow::chooseOpponent() {
+    bool accepted = false;
+
+    QString const side = QInputDialog::getItem(
+        this, "Computer", "Computer plays", {"Nobody", "White", "Black"},
+        this->computer ? static_cast<std::int32_t>(*this->computer) + 1 : 0,
+        false, &accepted
+    );
+
+    if (!accepted)
+        return;
+
+    if (side != "Nobody") {
+        std::int32_t const level = QInputDialog::getInt(
+            this, "Computer", "Level", this->level, 1,
+            static_cast<std::int32_t>(k_levels.size()), 1, &accepted
+        );
+
+        if (!accepted)
+            return;
+
+        std::int32_t const latency = QInputDialog::getInt(
+            this, "Computer", "Reply within (ms)",
+            static_cast<std::int32_t>(this->latency.count()), 1,
+            k_max_latency, 100, &accepted
+        );
+
+        if (!accepted)
+            return;
+
+        this->level = level;
+        this->latency = std::chrono::milliseconds(latency);
+    }
+
+    this->computer = side == "White"   ? std::optional(Colour::white)
+                     : side == "Black" ? std::optional(Colour::black)
+                                       : std::nullopt;
+
+    this->currentSquare = {0, 0};
+    this->selectedPiece = nullptr;
+
+    this->showPosition();
+}
+
+void MainWindow::think() {
+    Level const &level = k_levels[static_cast<std::size_t>(this->level - 1)];
+    std::uint64_t const generation = this->generation;
+
+    Limits const limits{
+        .depth = level.depth,
+        .nodes = level.nodes,
+        .time =
+            {this->clock->remaining(Colour::white),
+             this->clock->remaining(Colour::black)},
+        .increment = {this->clock->increment(), this->clock->increment()},
+        .cap = this->latency,
+    };
+
+    this->searchSignals.stop = false;
+
+    this->thinker = std::thread([this, position = fen(), history = k_history,
+                                 limits, level, generation]() -> void {
+        (void)load_fen(position);
+
+        k_history = history;
+
+        Searcher searcher(this->table, this->searchSignals);
+
+        Move move = searcher.search(limits).pv.front();
+
+        thread_local std::mt19937 random(std::random_device{}());
+
+        if (std::uniform_int_distribution(0, 99)(random) < level.blunders) {
+            std::vector<Move> candidates;
+
+            for (Move const &candidate : legal_moves())
+                if (candidate != move && see(candidate) >= 0)
+                    candidates.push_back(candidate);
+
+            if (!candidates.empty())
+                move = candidates[std::uniform_int_distribution<std::size_t>(
+                    0, candidates.size() - 1
+                )(random)];
+        }
+
+        clear_board();
+
+        QMetaObject::invokeMethod(
+            this,
+            [this, move, generation]() -> void {
+                this->playComputerMove(move, generation);
+            },
+            Qt::ConnectionType::QueuedConnection
+        );
+    });
+
+    QTimer::singleShot(this->latency, this, [this, generation]() -> void {
+        if (generation == this->generation)
+            this->searchSignals.stop = true;
+    });
+}
+
+void MainWindow::stopThinking() {
+    ++this->generation;
+
+    this->searchSignals.stop = true;
+
+    if (this->thinker.joinable())
+        this->thinker.join();
+}
+
+void MainWindow::playComputerMove(
+    Move const &move, std::uint64_t const generation
+) {
+    if (generation != this->generation)
+        return;
+
+    this->currentSquare = {0, 0};
+    this->selectedPiece = nullptr;
+
+    this->playMove(move);
+}
+
+void MainWindow::showStats(
+    std::string_view const move, Counters const &counters,
+    std::chrono::nanoseconds const elapsed
+) {
+    if (!counters_enabled()) {
+        this->stats->setText("Counters are compiled out");
+        this->stats->adjustSize();
+
+        return;
+    }
+
+    Counters const totals = ::counters();
+
+    std::string text = std::format(
+        "{:<12}{:>10}{:>12}\n{:<12}{:>10.3f}{:>12}", "",
+        move.empty() ? "-" : move, "total", "ms",
+        std::chrono::duration<double, std::milli>(elapsed).count(), ""
+    );
+
+    for (std::size_t i = 0; i < k_counter_count; ++i)
+        text += std::format(
+            "\n{:<12}{:>10}{:>12}", k_counter_names[i], counters[i], totals[i]
+        );
+
+    this->stats->setText(QString::fromStdString(text));
+    this->stats->adjustSize();
+}
+
+auto MainWindow::event(QEvent *event) -> bool {
+    if (event->type() != QEvent::Type::UpdateRequest)
+        return QDialog::event(event);
+
+    TraceSpan const span("paint");
+
+    return QDialog::event(event);
+}
+
 void MainWindow::closeEvent(QCloseEvent *event) {
-    for (Piece const *piece : k_pieces | std::views::values)
-        delete piece;
+    this->stopThinking();
+    this->joinSolver();
+
+    clear_board();
 
     QDialog::closeEvent(event);
 }
\ No newline at end of file
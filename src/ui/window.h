@@ -1,7 +1,18 @@
 #ifndef WINDOW_H
 #define WINDOW_H
 
+#include "../game/game.h"
+#include "../search/search.h"
+#include "../search/table.h"
 #include "../square.h"
+#include "../stats/stats.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <thread>
 
 #include <qapplication.h>
 #include <qdialog.h>
@@ -9,34 +20,97 @@
 class QLabel;
 
 struct Piece;
+class ChessClock;
 class MoveRecord;
+class OpeningExplorer;
 
 class MainWindow final : public QDialog {
   public:
     explicit MainWindow(QWidget *parent = nullptr);
 
+    ~MainWindow() override;
+
   private:
+    friend class ReplayHarness;
+
     QLabel *player = nullptr;
+    ChessClock *clock = nullptr;
+    QLabel *stats = nullptr;
     MoveRecord *record = nullptr;
+    OpeningExplorer *explorer = nullptr;
+    QPushButton *solveButton = nullptr;
 
     Piece *selectedPiece = nullptr;
     Square currentSquare;
 
-    std::map<Square, QPushButton *> buttons;
+    std::array<QPushButton *, 64> buttons{};
+
+    GameTree game;
+
+    std::optional<Colour> computer;
+    std::int32_t level = 4;
+    std::chrono::milliseconds latency = std::chrono::seconds(1);
+    TranspositionTable table{16};
+    Signals searchSignals;
+    std::thread thinker;
+    std::uint64_t generation = 0;
+    std::thread solver;
+    std::atomic<bool> stopSolver = false;
 
     std::int32_t const k_font_size =
         QFontMetrics(QApplication::font()).horizontalAdvance(' ') * 16;
 
     void setBoard();
 
+    void drawBoard();
+
     void selectPiece(Square const &square);
 
     void prepareMove(Square square);
 
     void makeMove(Square square);
 
+    void playMove(Move const &move);
+
+    void recordMove(PackedMove packed);
+
+    void showPosition();
+
+    void undoMove();
+
+    void redoMove();
+
+    void jumpTo(std::size_t ply);
+
+    void saveGame();
+
+    void loadGame();
+
+    void openIndex();
+
+    void loadNetwork();
+
+    void solvePuzzle();
+
+    void joinSolver();
+
     void newGame();
 
+    void chooseOpponent();
+
+    void think();
+
+    void stopThinking();
+
+    void playComputerMove(Move const &move, std::uint64_t generation);
+
+    void showStats(
+        std::string_view move, Counters const &counters,
+        std::chrono::nanoseconds elapsed
+    );
+
+    auto event(QEvent *event) -> bool override;
+
     void closeEvent(QCloseEvent *event) override;
 };
 
@@ -1,42 +1,93 @@
 #ifndef VARS_H
 #define VARS_H
 
+#include "board/zobrist.h"
 #include "colour.h"
+#include "eval/eval.h"
+#include "nnue/nnue.h"
 #include "square.h"
 
 #include <array>
-#include <map>
-#include <ranges>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
 
 struct Piece;
 
-inline static std::array<std::array<Square, 8>, 8> constexpr k_board{
-    Square{0, 0}, Square{0, 1}, Square{0, 2}, Square{0, 3}, Square{0, 4},
-    Square{0, 5}, Square{0, 6}, Square{0, 7}, Square{1, 0}, Square{1, 1},
-    Square{1, 2}, Square{1, 3}, Square{1, 4}, Square{1, 5}, Square{1, 6},
-    Square{1, 7}, Square{2, 0}, Square{2, 1}, Square{2, 2}, Square{2, 3},
-    Square{2, 4}, Square{2, 5}, Square{2, 6}, Square{2, 7}, Square{3, 0},
-    Square{3, 1}, Square{3, 2}, Square{3, 3}, Square{3, 4}, Square{3, 5},
-    Square{3, 6}, Square{3, 7}, Square{4, 0}, Square{4, 1}, Square{4, 2},
-    Square{4, 3}, Square{4, 4}, Square{4, 5}, Square{4, 6}, Square{4, 7},
-    Square{5, 0}, Square{5, 1}, Square{5, 2}, Square{5, 3}, Square{5, 4},
-    Square{5, 5}, Square{5, 6}, Square{5, 7}, Square{6, 0}, Square{6, 1},
-    Square{6, 2}, Square{6, 3}, Square{6, 4}, Square{6, 5}, Square{6, 6},
-    Square{6, 7}, Square{7, 0}, Square{7, 1}, Square{7, 2}, Square{7, 3},
-    Square{7, 4}, Square{7, 5}, Square{7, 6}, Square{7, 7},
+inline static std::array<Square, 64> constexpr k_squares = [] {
+    std::array<Square, 64> squares;
+
+    for (std::size_t index = 0; index < squares.size(); ++index)
+        squares[index] = Square(index);
+
+    return squares;
+}();
+inline static std::array<std::array<Square, 8>, 8> constexpr k_board = [] {
+    std::array<std::array<Square, 8>, 8> board;
+
+    for (Square const &square : k_squares)
+        board[square.rank()][square.file()] = square;
+
+    return board;
+}();
+
+struct Attacks final {
+    std::array<Square, 8> squares{};
+    std::size_t size = 0;
+
+    [[nodiscard]] constexpr auto begin() const -> Square const * {
+        return this->squares.data();
+    }
+
+    [[nodiscard]] constexpr auto end() const -> Square const * {
+        return this->squares.data() + this->size;
+    }
 };
-inline std::map<Square, Piece *> k_pieces =
-    k_board | std::views::join |
-    std::views::transform(
-        [](Square const &square) -> std::pair<Square, Piece *> {
-            return {square, nullptr};
+
+using AttackTable = std::array<Attacks, 64>;
+
+inline static auto constexpr k_attacks =
+    [](std::initializer_list<std::pair<Rank, File>> const offsets)
+    -> AttackTable {
+    AttackTable table{};
+
+    for (Square const &square : k_squares) {
+        Attacks &attacks = table[square];
+
+        for (auto const &[rank_offset, file_offset] : offsets) {
+            Rank const rank = square.rank() + rank_offset;
+            File const file = square.file() + file_offset;
+
+            if (rank >= 0 && rank < 8 && file >= 0 && file < 8)
+                attacks.squares[attacks.size++] = {rank, file};
         }
-    ) |
-    std::ranges::to<std::map<Square, Piece *>>();
-inline std::map<Colour, Square> k_king_pos = {
-    {Colour::white, k_board[7][4]},
-    {Colour::black, k_board[0][4]},
+    }
+
+    return table;
+};
+
+inline static AttackTable constexpr k_knight_attacks = k_attacks({
+    {-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1},
+});
+inline static AttackTable constexpr k_king_attacks = k_attacks({
+    {-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1},
+});
+inline static std::array<AttackTable, 2> constexpr k_pawn_attacks{
+    k_attacks({{-1, -1}, {-1, 1}}),
+    k_attacks({{1, -1}, {1, 1}}),
+};
+inline thread_local std::array<Piece *, 64> k_pieces{};
+inline thread_local std::array<Square, 2> k_king_pos{
+    k_board[7][4],
+    k_board[0][4],
 };
-inline auto k_current_player = Colour::white;
+inline thread_local auto k_current_player = Colour::white;
+inline thread_local Evaluation k_evaluation;
+inline thread_local Accumulator k_accumulator;
+inline thread_local Hash k_hash = 0;
+inline thread_local Hash k_pawn_hash = 0;
+inline thread_local std::vector<Hash> k_history;
+inline thread_local std::int32_t k_halfmove_clock = 0;
+inline thread_local std::int32_t k_fullmove_number = 1;
 
 #endif